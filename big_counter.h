@@ -0,0 +1,135 @@
+// AoC 2025 - overflow safe counters
+// =================================
+
+// date:  2026-10-19
+
+#ifndef BIG_COUNTER_H
+#define BIG_COUNTER_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+
+//                          +--------------------+                           //
+// -------------------------+ MODULE DESCRIPTION +-------------------------- //
+//                          +--------------------+                           //
+
+/*
+ * Counting paths or time lines easily grows exponentially, so a long long can silently overflow. This
+ * module makes counting code generic over the counter type:
+ *   - long long          - the fast default;
+ *   - unsigned __int128  - twice the width, still a native type;
+ *   - BigCount           - arbitrary precision, cannot overflow.
+ *
+ * Counting code is written as a template on CountT, and adds counts with AddOverflows(), which reports
+ * an overflow instead of wrapping around. CountWidening() runs such counting code with long long first,
+ * and only if that overflows, reruns it with unsigned __int128, and then with BigCount.
+ */
+
+//                               +----------+                                //
+// ------------------------------+ BIGCOUNT +------------------------------- //
+//                               +----------+                                //
+
+// arbitrary precision non negative integer, supporting what counting needs: adding and printing
+class BigCount {
+
+public:
+    BigCount( unsigned long long n = 0 ) {
+        while (n > 0) {
+            vLimbs.push_back( n % LIMB_BASE );
+            n /= LIMB_BASE;
+        }
+    }
+
+    BigCount &operator += ( const BigCount &rhs ) {
+        unsigned nCarry = 0;
+        size_t nSize = std::max( vLimbs.size(), rhs.vLimbs.size());
+        vLimbs.resize( nSize, 0 );
+        for (size_t i = 0; i < nSize; i++) {
+            unsigned long long llSum = (unsigned long long)vLimbs[i] + nCarry + (i < rhs.vLimbs.size() ? rhs.vLimbs[i] : 0);
+            vLimbs[i] = llSum % LIMB_BASE;
+            nCarry    = llSum / LIMB_BASE;
+        }
+        if (nCarry > 0) {
+            vLimbs.push_back( nCarry );
+        }
+        return *this;
+    }
+
+    BigCount operator + ( const BigCount &rhs ) const { BigCount result = *this; result += rhs; return result; }
+
+    bool operator == ( const BigCount &rhs ) const { return vLimbs == rhs.vLimbs; }
+    bool operator != ( const BigCount &rhs ) const { return vLimbs != rhs.vLimbs; }
+
+    std::string ToString() const {
+        if (vLimbs.empty()) {
+            return "0";
+        }
+        std::string sResult = std::to_string( vLimbs.back());
+        for (int i = (int)vLimbs.size() - 2; i >= 0; i--) {
+            std::string sLimb = std::to_string( vLimbs[i] );
+            sResult += std::string( LIMB_DIGITS - sLimb.length(), '0' ) + sLimb;
+        }
+        return sResult;
+    }
+
+private:
+    static const unsigned LIMB_BASE   = 1000000000;    // each limb holds 9 decimal digits
+    static const int      LIMB_DIGITS = 9;
+
+    std::vector<unsigned> vLimbs;                      // least significant limb first, no leading zero limbs
+};
+
+inline std::ostream &operator << ( std::ostream &os, const BigCount &c ) {
+    return os << c.ToString();
+}
+
+//                            +---------------+                              //
+// ---------------------------+ COUNTER UTILS +----------------------------- //
+//                            +---------------+                              //
+
+typedef unsigned __int128 u128;
+
+// adds b to a, and returns true if the result overflowed (a is then invalid)
+template <class T>
+inline bool AddOverflows( T &a, const T &b ) {
+    return __builtin_add_overflow( a, b, &a );
+}
+
+inline bool AddOverflows( BigCount &a, const BigCount &b ) {
+    a += b;
+    return false;
+}
+
+// converts a count to a string, for any of the counter types
+inline std::string CountToString( long long n ) { return std::to_string( n ); }
+inline std::string CountToString( const BigCount &n ) { return n.ToString(); }
+inline std::string CountToString( u128 n ) {
+    std::string sResult;
+    do {
+        sResult.push_back( '0' + (int)(n % 10));
+        n /= 10;
+    } while (n > 0);
+    std::reverse( sResult.begin(), sResult.end());
+    return sResult;
+}
+
+// Calls fnCount( CountT() ) with CountT = long long, and if that overflows with u128, and if that
+// overflows too with BigCount. fnCount must return a std::pair< bool (overflow), CountT (count) >.
+// Returns the first count that didn't overflow, as a string.
+template <class F>
+std::string CountWidening( F fnCount ) {
+    std::pair<bool, long long> result64 = fnCount( (long long)0 );
+    if (!result64.first) {
+        return CountToString( result64.second );
+    }
+    std::pair<bool, u128> result128 = fnCount( (u128)0 );
+    if (!result128.first) {
+        return CountToString( result128.second );
+    }
+    return CountToString( fnCount( BigCount( 0 )).second );
+}
+
+#endif // BIG_COUNTER_H
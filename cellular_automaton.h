@@ -0,0 +1,151 @@
+// AoC 2025 - threshold cellular automaton engine
+// ==============================================
+
+// date:  2026-10-19
+
+#ifndef CELLULAR_AUTOMATON_H
+#define CELLULAR_AUTOMATON_H
+
+#include <vector>
+#include <algorithm>
+
+#include "thread_pool.h"
+
+//                          +--------------------+                           //
+// -------------------------+ MODULE DESCRIPTION +-------------------------- //
+//                          +--------------------+                           //
+
+/*
+ * A reusable engine for cellular automata on a dense grid, where the new state of a cell depends on
+ * its own state and the nr of "live" (non zero) cells in its neighbourhood.
+ *
+ *   - the neighbourhood is either the 4 orthogonal or all 8 surrounding cells. Cells outside the
+ *     grid count as not live;
+ *   - the rule is any function (or lambda) fnRule( cState, nLiveNeighbours ) -> new state. For the
+ *     common case of a threshold rule, ThresholdRule can be used;
+ *   - generations are double buffered: each generation is computed from the previous one into a
+ *     second buffer, after which the buffers are swapped;
+ *   - the rows are split into bands, that are processed in parallel on the thread pool;
+ *   - changed cells are tracked per band. A band is only recomputed if it, or one of the bands next
+ *     to it, changed in the previous generation, and the run stops as soon as nothing changes.
+ */
+
+//                             +------------+                                //
+// ----------------------------+ DEFINITION +------------------------------- //
+//                             +------------+                                //
+
+enum eNeighbourhood {
+    NEIGHBOURS_4 = 4,    // orthogonal neighbours only
+    NEIGHBOURS_8 = 8     // orthogonal and diagonal neighbours
+};
+
+typedef unsigned char CellType;
+
+typedef struct {
+    int nWidth, nHeight;
+    std::vector<CellType> vCells;    // row major, nWidth * nHeight cells
+} CellGridType;
+
+// creates a grid of nWidth x nHeight cells, that all have state cInit
+inline CellGridType CreateCellGrid( int nWidth, int nHeight, CellType cInit = 0 ) {
+    return { nWidth, nHeight, std::vector<CellType>( nWidth * nHeight, cInit ) };
+}
+
+// A cell in state cFrom goes to state cTo if its nr of live neighbours is in [ nMin, nMax ].
+// All other cells keep their state.
+struct ThresholdRule {
+    CellType cFrom, cTo;
+    int      nMin , nMax;
+
+    CellType operator () ( CellType c, int nLive ) const {
+        return (c == cFrom && nMin <= nLive && nLive <= nMax) ? cTo : c;
+    }
+};
+
+// statistics of a run of the automaton
+typedef struct {
+    int       nGenerations;    // nr of generations in which at least one cell changed
+    long long llChanges;       // total nr of cell changes over all generations
+} RunStatsType;
+
+//                           +----------------+                              //
+// --------------------------+ IMPLEMENTATION +----------------------------- //
+//                           +----------------+                              //
+
+// nr of rows per band
+#define CA_BAND_ROWS  16
+
+// returns the nr of live neighbours of cell (x, y) in grid g
+inline int NrLiveNeighbours( const CellGridType &g, int x, int y, eNeighbourhood eN ) {
+    int nLive = 0;
+    for (int dy = -1; dy <= 1; dy++) {
+        int ny = y + dy;
+        if (ny < 0 || ny >= g.nHeight) continue;
+        for (int dx = -1; dx <= 1; dx++) {
+            int nx = x + dx;
+            if (nx < 0 || nx >= g.nWidth || (dx == 0 && dy == 0)) continue;
+            if (eN == NEIGHBOURS_4 && dx != 0 && dy != 0) continue;
+            nLive += (g.vCells[ny * g.nWidth + nx] != 0) ? 1 : 0;
+        }
+    }
+    return nLive;
+}
+
+// Runs the automaton on grid g with neighbourhood eN and rule fnRule, until no cell changes anymore,
+// or nMaxGenerations generations are done (if nMaxGenerations >= 0). The grid holds the end state
+// when the function returns.
+template <class R>
+RunStatsType RunAutomaton( CellGridType &g, eNeighbourhood eN, R fnRule, int nMaxGenerations = -1 ) {
+    RunStatsType stats = { 0, 0 };
+    if (g.nWidth <= 0 || g.nHeight <= 0) {
+        return stats;
+    }
+    int nBands = (g.nHeight + CA_BAND_ROWS - 1) / CA_BAND_ROWS;
+    CellGridType next = g;
+    // initially all bands must be computed
+    std::vector<char> vChanged( nBands, 1 ), vNextChanged( nBands, 0 );
+
+    while (nMaxGenerations < 0 || stats.nGenerations < nMaxGenerations) {
+        long long llChanges = ParallelReduce(
+            0, nBands, 0LL,
+            [&]( long long lo, long long hi ) {
+                long long llBandChanges = 0;
+                for (long long b = lo; b < hi; b++) {
+                    int nRow1 = b * CA_BAND_ROWS;
+                    int nRow2 = std::min( g.nHeight, nRow1 + CA_BAND_ROWS );
+                    bool bActive = vChanged[b] || (b > 0 && vChanged[b - 1]) || (b + 1 < nBands && vChanged[b + 1]);
+                    long long llCount = 0;
+                    if (bActive) {
+                        for (int y = nRow1; y < nRow2; y++) {
+                            for (int x = 0; x < g.nWidth; x++) {
+                                CellType cOld = g.vCells[y * g.nWidth + x];
+                                CellType cNew = fnRule( cOld, NrLiveNeighbours( g, x, y, eN ));
+                                next.vCells[y * g.nWidth + x] = cNew;
+                                llCount += (cNew != cOld) ? 1 : 0;
+                            }
+                        }
+                    } else {
+                        // nothing around this band changed, so the band stays the same
+                        std::copy( g.vCells.begin() + nRow1 * g.nWidth, g.vCells.begin() + nRow2 * g.nWidth,
+                                   next.vCells.begin() + nRow1 * g.nWidth );
+                    }
+                    vNextChanged[b] = (llCount > 0);
+                    llBandChanges += llCount;
+                }
+                return llBandChanges;
+            },
+            []( long long a, long long b ) { return a + b; },
+            1
+        );
+        if (llChanges == 0) {
+            break;
+        }
+        std::swap( g.vCells, next.vCells );
+        std::swap( vChanged, vNextChanged );
+        stats.nGenerations += 1;
+        stats.llChanges += llChanges;
+    }
+    return stats;
+}
+
+#endif // CELLULAR_AUTOMATON_H
@@ -0,0 +1,148 @@
+// AoC 2025 - bounded selection of the closest pairs
+// =================================================
+
+// date:  2026-10-19
+
+#ifndef CLOSEST_PAIRS_H
+#define CLOSEST_PAIRS_H
+
+#include <vector>
+#include <algorithm>
+
+#include "thread_pool.h"
+
+//                          +--------------------+                           //
+// -------------------------+ MODULE DESCRIPTION +-------------------------- //
+//                          +--------------------+                           //
+
+/*
+ * Selects the K closest pairs out of all n * (n - 1) / 2 pairs of n points, without materialising the
+ * pair list. The distance is given by a function fnDist2( i, j ) that returns the squared distance as
+ * an integer, so there are no rounding issues. Pairs are ordered on (distance, i, j), so ties are
+ * broken deterministically, and the order is strict.
+ *
+ *   - the pairs are generated in blocks of rows (all pairs (i, j) with i in the block and j > i), that
+ *     are processed in parallel on the thread pool. Row i has n - 1 - i pairs, so the blocks are cut on
+ *     the nr of pairs instead of the nr of rows, to give every block about the same amount of work;
+ *   - each block streams its pairs through a bounded max heap holding the K smallest pairs so far. A
+ *     pair that is not smaller than the top of a full heap is rejected with a single compare;
+ *   - the heaps of the blocks are combined into one, and sorted at the end.
+ *
+ * This takes O(n^2 log K) time worst case, but only O(n + K) memory.
+ *
+ * A PairBatchIterType hands out the pairs in increasing order, in batches of K: each next batch holds
+ * the K smallest pairs that are larger than the last pair of the previous batch.
+ *
+ * NOTE: this is a brute force reference implementation, meant for checking. Each batch scans all pairs
+ * again, so handing out m pairs takes O((m / K) * n^2 log K) time. To get the closest pairs one by one
+ * in a solution, use the closest pair traversal of kd_tree.h.
+ */
+
+typedef struct {
+    int       nA, nB;        // indices of the points of the pair, nA < nB
+    long long llDist2;       // squared distance between the points
+} PairEdgeType;
+typedef std::vector<PairEdgeType> PairEdgeStream;
+
+// returns true if pair a is smaller than pair b, on (distance, nA, nB)
+inline bool PairLess( const PairEdgeType &a, const PairEdgeType &b ) {
+    if (a.llDist2 != b.llDist2) return a.llDist2 < b.llDist2;
+    if (a.nA      != b.nA     ) return a.nA      < b.nA     ;
+    return a.nB < b.nB;
+}
+
+// adds pair e to the bounded max heap vHeap, that holds at most nK pairs
+inline void PushBounded( PairEdgeStream &vHeap, int nK, const PairEdgeType &e ) {
+    if ((int)vHeap.size() < nK) {
+        vHeap.push_back( e );
+        std::push_heap( vHeap.begin(), vHeap.end(), PairLess );
+    } else if (PairLess( e, vHeap.front())) {
+        std::pop_heap( vHeap.begin(), vHeap.end(), PairLess );
+        vHeap.back() = e;
+        std::push_heap( vHeap.begin(), vHeap.end(), PairLess );
+    }
+}
+
+// Returns the first rows of (at most) nChunks blocks of rows of nPoints points, such that all blocks
+// hold about the same nr of pairs. The last entry is nPoints, so block c is [ vStart[c], vStart[c + 1] ).
+inline std::vector<int> BalancedRowBlocks( int nPoints, int nChunks ) {
+    long long llTotal = (long long)nPoints * (nPoints - 1) / 2;
+    long long llPairs = 0;
+    std::vector<int> vStart = { 0 };
+    for (int i = 0; i < nPoints; i++) {
+        llPairs += nPoints - 1 - i;
+        // close the current block as soon as it reaches its share of the pairs
+        if ((int)vStart.size() < nChunks && llPairs * nChunks >= llTotal * (long long)vStart.size()) {
+            vStart.push_back( i + 1 );
+        }
+    }
+    if (vStart.back() < nPoints) {
+        vStart.push_back( nPoints );
+    }
+    return vStart;
+}
+
+// Returns the (at most) nK smallest pairs of the nPoints points, that are larger than pAfter (if not
+// nullptr), sorted in increasing order. The result doesn't depend on the blocks, since the order is strict.
+template <class F>
+PairEdgeStream SmallestPairs( int nPoints, F fnDist2, int nK, const PairEdgeType *pAfter = nullptr ) {
+    std::vector<int> vStart = BalancedRowBlocks( nPoints, GlobalPool().NrThreads() * POOL_CHUNKS_PER_THREAD );
+    PairEdgeStream vResult = ParallelReduce(
+        0, (int)vStart.size() - 1, PairEdgeStream(),
+        [&]( long long cLo, long long cHi ) {
+            PairEdgeStream vHeap;
+            vHeap.reserve( nK );
+            for (int i = vStart[cLo]; i < vStart[cHi]; i++) {
+                for (int j = i + 1; j < nPoints; j++) {
+                    long long llDist2 = fnDist2( i, j );
+                    // cheap reject on distance alone, before the full compare
+                    if ((int)vHeap.size() == nK && llDist2 > vHeap.front().llDist2) continue;
+                    PairEdgeType e = { i, j, llDist2 };
+                    if (pAfter != nullptr && !PairLess( *pAfter, e )) continue;
+                    PushBounded( vHeap, nK, e );
+                }
+            }
+            return vHeap;
+        },
+        [&]( PairEdgeStream a, const PairEdgeStream &b ) {
+            for (auto &e : b) {
+                PushBounded( a, nK, e );
+            }
+            return a;
+        },
+        1
+    );
+    std::sort_heap( vResult.begin(), vResult.end(), PairLess );
+    return vResult;
+}
+
+// hands out all pairs in increasing order, in batches
+typedef struct {
+    int          nPoints;
+    int          nBatchSize;
+    PairEdgeType last;        // last pair of the previous batch
+    bool         bStarted;    // false until the first batch is handed out
+    bool         bDone;       // true if all pairs are handed out
+} PairBatchIterType;
+
+// creates an iterator over the pairs of nPoints points, in batches of nBatchSize pairs
+inline PairBatchIterType CreatePairBatchIter( int nPoints, int nBatchSize ) {
+    return { nPoints, nBatchSize, { 0, 0, 0 }, false, nPoints < 2 };
+}
+
+// returns the next batch of smallest pairs, or an empty batch if all pairs are handed out
+template <class F>
+PairEdgeStream NextPairBatch( PairBatchIterType &iter, F fnDist2 ) {
+    PairEdgeStream vBatch;
+    if (!iter.bDone) {
+        vBatch = SmallestPairs( iter.nPoints, fnDist2, iter.nBatchSize, iter.bStarted ? &iter.last : nullptr );
+        iter.bStarted = true;
+        iter.bDone = ((int)vBatch.size() < iter.nBatchSize);
+        if (!vBatch.empty()) {
+            iter.last = vBatch.back();
+        }
+    }
+    return vBatch;
+}
+
+#endif // CLOSEST_PAIRS_H
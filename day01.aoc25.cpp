@@ -15,6 +15,8 @@
 #include "../flcTimer.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
+#include "run_parts.h"                 // used for running both parts concurrently
+#include "thread_pool.h"               // used for parallel loops
 
 // ==========   PROGRAM STAGING
 
@@ -33,6 +35,11 @@ std::string ProgPhase2string() {
     return "unknown";
 }
 
+enum eExecMode {      // how to run the two parts - set at start of main()
+    SEQUENTIAL = 0,   //    1. solve part 1 first, then part 2
+    CONCURRENT        //    2. solve part 1 and part 2 as parallel tasks, and join them before reporting
+} glbExecMode;
+
 // ==========   INPUT DATA STRUCTURES          <<===== adapt to match columns of input file
 
 // the data consists of tuples (pairs) of numbers
@@ -129,97 +136,236 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 
 // ----- PART 1
 
+// constant time modulo, the result is always in [ 0, oper )
 int my_mod( int nr, int oper ) {
-    int nResult = nr;
-    while (nResult >= oper) { nResult -= oper; }
-    while (nResult <     0) { nResult += oper; }
-    return nResult;
+    int nResult = nr % oper;
+    return nResult < 0 ? nResult + oper : nResult;
+}
+
+// constant time floor division (rounds towards minus infinity) - oper must be > 0
+long long my_floor_div( long long nr, long long oper ) {
+    long long llResult = nr / oper;
+    return llResult - ((nr % oper) < 0 ? 1 : 0);
+}
+
+/*
+ * The dial is simulated as a scan: if the rotations are not reduced modulo 100, the "absolute" dial
+ * position after rotation i is just the start value plus the prefix sum of the rotations up to i.
+ *   - the dial points at 0 after rotation i if that absolute position is a multiple of 100;
+ *   - the number of times it passes (or ends on) 0 during a rotation follows from floor divisions:
+ *       rotating right from A to B: floor( B / 100 ) - floor( A / 100 )
+ *       rotating left  from A to B: floor( (A - 1) / 100 ) - floor( (B - 1) / 100 )
+ * Neither count depends on the previous rotation, other than through the prefix sum. So the stream is
+ * cut into fixed size blocks: the block sums are computed in parallel, a (short) serial scan over them
+ * gives the start position of each block, and then all blocks are counted in parallel.
+ */
+
+// nr of rotations per block of the scan - fixed, so that the result doesn't depend on the nr of cores
+#define DIAL_BLOCK  65536
+
+// the counts that are gathered in one scan over the rotation stream
+typedef struct {
+    long long llEndingAtZero;     // part 1: nr of rotations that leave the dial at 0
+    long long llPassingZero;      // part 2: nr of times the dial points at 0, during or after a rotation
+} ZeroCountType;
+
+// counts the zeros for the rotations [ nLo, nHi ) of dData, starting at absolute dial position llStart
+ZeroCountType ScanBlock( const DataStream &dData, long long nLo, long long nHi, long long llStart ) {
+    long long llPos = llStart, llEnding = 0, llPassing = 0;
+    for (long long i = nLo; i < nHi; i++) {
+        long long llNew = llPos + dData[i].nr;
+        llEnding += (my_floor_div( llNew, 100 ) * 100 == llNew) ? 1 : 0;
+        llPassing += (dData[i].nr >= 0)
+            ? my_floor_div( llNew    , 100 ) - my_floor_div( llPos    , 100 )     // rotate dial to right
+            : my_floor_div( llPos - 1, 100 ) - my_floor_div( llNew - 1, 100 );    // rotate dial to left
+        llPos = llNew;
+    }
+    return { llEnding, llPassing };
+}
+
+// returns the absolute dial position at the start of each block of the scan over dData (passes 1 and 2)
+std::vector<long long> GetBlockStarts( const DataStream &dData, int nStart ) {
+    long long nSize   = dData.size();
+    long long nBlocks = (nSize + DIAL_BLOCK - 1) / DIAL_BLOCK;
+
+    // pass 1 - get the sum of the rotations per block
+    std::vector<long long> vBlockStart( nBlocks + 1, 0 );
+    ParallelFor(
+        0, nSize,
+        [&]( long long lo, long long hi ) {
+            long long llSum = 0;
+            for (long long i = lo; i < hi; i++) {
+                llSum += dData[i].nr;
+            }
+            vBlockStart[lo / DIAL_BLOCK + 1] = llSum;
+        },
+        DIAL_BLOCK
+    );
+    // pass 2 - serial scan over the block sums gives the absolute start position per block
+    vBlockStart[0] = nStart;
+    for (long long b = 1; b <= nBlocks; b++) {
+        vBlockStart[b] += vBlockStart[b - 1];
+    }
+    return vBlockStart;
+}
+
+// runs the block scan over the rotations in dData, starting with the dial at nStart
+ZeroCountType ScanDial( const DataStream &dData, int nStart ) {
+    long long nSize = dData.size();
+    std::vector<long long> vBlockStart = GetBlockStarts( dData, nStart );
+    // pass 3 - count the zeros per block, and combine the block counts in order
+    return ParallelReduce(
+        0, nSize, ZeroCountType{ 0, 0 },
+        [&]( long long lo, long long hi ) {
+            return ScanBlock( dData, lo, hi, vBlockStart[lo / DIAL_BLOCK] );
+        },
+        []( ZeroCountType a, ZeroCountType b ) {
+            return ZeroCountType{ a.llEndingAtZero + b.llEndingAtZero, a.llPassingZero + b.llPassingZero };
+        },
+        DIAL_BLOCK
+    );
 }
 
-int my_div( int nr, int oper ) {
-    int nResult = (nr < 0 ? -( nr / oper) : (nr / oper));
-    return nResult;
+// solves part 1: count the number of times the dial points at 0 after a rotation
+long long SolvePart1( const DataStream &inputData ) {
+    return ScanDial( inputData, 50 ).llEndingAtZero;
 }
 
 // ----- PART 2
 
+// solves part 2: count the number of times the dial points at 0, both during and after a rotation
+long long SolvePart2( const DataStream &inputData ) {
+    return ScanDial( inputData, 50 ).llPassingZero;
+}
+
+// ----- ALL STARTING POSITIONS
+
+/*
+ * For what-if analyses, the answers to both parts are needed for every starting position of the dial.
+ * Instead of running the scan 100 times, all starting positions S are evaluated in one pass. Let p be
+ * the dial position before rotation i when starting at 0, then for start S it is (S + p) mod 100:
+ *   - part 1: the dial ends at 0 if S == (-p') mod 100, where p' is the position after the rotation.
+ *     So a histogram over (-p') mod 100 gives the part 1 answer for all S at once;
+ *   - part 2: a rotation by r always passes 0 exactly |r| / 100 times for any S, plus once more if
+ *     a = (S + p) mod 100 lies in [ 100 - m, 99 ] (rotating right) or in [ 1, m ] (rotating left),
+ *     with m = |r| mod 100. That is a cyclic interval of S values, which is added to a difference
+ *     array in constant time.
+ * The blocks of the scan are processed in parallel and their tallies are added up in order.
+ */
+
+// the counts per starting position that are gathered in one scan over the rotation stream
+typedef struct {
+    long long vEndingAtZero[100];    // histogram of starting positions that end on 0
+    long long vPassingDiff[101];     // difference array of starting positions that pass 0 an extra time
+    long long llPassingAll;          // nr of times 0 is passed for any starting position
+} AllStartsType;
+
+// adds 1 to the difference array entries for the cyclic interval of starting positions [ nLo, nHi ] mod 100
+void AddCyclicInterval( AllStartsType &tally, int nLo, int nHi ) {
+    nLo = my_mod( nLo, 100 );
+    nHi = my_mod( nHi, 100 );
+    tally.vPassingDiff[nLo] += 1;
+    tally.vPassingDiff[nHi + 1] -= 1;
+    if (nLo > nHi) {                    // the interval wraps around
+        tally.vPassingDiff[0] += 1;
+        tally.vPassingDiff[100] -= 1;
+    }
+}
+
+// tallies the rotations [ nLo, nHi ) of dData, where llStart is the position at nLo when starting at 0
+AllStartsType ScanBlockAllStarts( const DataStream &dData, long long nLo, long long nHi, long long llStart ) {
+    AllStartsType tally = {};
+    int nPos = my_mod( llStart % 100, 100 );
+    for (long long i = nLo; i < nHi; i++) {
+        int nRot = dData[i].nr;
+        int nAbs = nRot < 0 ? -nRot : nRot;
+        int nRem = nAbs % 100;
+        tally.llPassingAll += nAbs / 100;
+        if (nRem > 0) {
+            if (nRot > 0) {                 // rotate dial to right
+                AddCyclicInterval( tally, 100 - nRem - nPos, 99 - nPos );
+            } else {                        // rotate dial to left
+                AddCyclicInterval( tally, 1 - nPos, nRem - nPos );
+            }
+        }
+        nPos = my_mod( nPos + nRot % 100, 100 );
+        tally.vEndingAtZero[my_mod( -nPos, 100 )] += 1;
+    }
+    return tally;
+}
 
+// Returns the answers to part 1 and part 2 for every starting position 0..99 of the dial, in vPart1
+// and vPart2 respectively, using a single scan over the rotations in dData
+void ScanAllStarts( const DataStream &dData, std::vector<long long> &vPart1, std::vector<long long> &vPart2 ) {
+    long long nSize = dData.size();
+    std::vector<long long> vBlockStart = GetBlockStarts( dData, 0 );
+    AllStartsType tally = ParallelReduce(
+        0, nSize, AllStartsType{},
+        [&]( long long lo, long long hi ) {
+            return ScanBlockAllStarts( dData, lo, hi, vBlockStart[lo / DIAL_BLOCK] );
+        },
+        []( AllStartsType a, const AllStartsType &b ) {
+            for (int i = 0; i < 100; i++) { a.vEndingAtZero[i] += b.vEndingAtZero[i]; }
+            for (int i = 0; i < 101; i++) { a.vPassingDiff[ i] += b.vPassingDiff[ i]; }
+            a.llPassingAll += b.llPassingAll;
+            return a;
+        },
+        DIAL_BLOCK
+    );
+    // the zeros that a rotation ends on are counted in part 2 as well
+    vPart1.assign( 100, 0 );
+    vPart2.assign( 100, 0 );
+    long long llRunning = 0;
+    for (int s = 0; s < 100; s++) {
+        llRunning += tally.vPassingDiff[s];
+        vPart1[s] = tally.vEndingAtZero[s];
+        vPart2[s] = tally.llPassingAll + llRunning;
+    }
+}
 
 // ==========   MAIN()
 
 int main()
 {
     glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    glbExecMode = CONCURRENT;  // execution mode SEQUENTIAL or CONCURRENT
     std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
     flcTimer tmr;
 
 /* ========== */   tmr.StartTiming();   // ============================================vvvvv
 
     // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream inputData;
-    GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
+    DataStream parsedData;
+    GetInput( parsedData, glbProgPhase != PUZZLE );
+    // both parts only read the input data, so they share it instead of each working on a copy
+    const DataStream &inputData = parsedData;
     std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
 
 /* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
 
-    // part 1 code here
-    int nDialValue = 50, nZeros = 0;
-//    std::cout << "the dial starts by pointing at: " << nDialValue << ", nr of zeros = " << nZeros << std::endl;
-
-    for (int i = 0; i < (int)inputData.size(); i++) {
-        nDialValue = my_mod( nDialValue + inputData[i].nr, 100 );
-        if (nDialValue == 0) {
-            nZeros += 1;
-        }
-
-//        std::cout << "the dial is rotated: ";
-//        PrintDatum( inputData[i], false );
-//        std::cout << " to point at: " << nDialValue << ", nr of zeros = " << nZeros<< std::endl;
-    }
-
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 1 = " << nZeros << std::endl << std::endl;
+    // solve both parts, sequentially or concurrently depending on glbExecMode
+    auto results = RunParts(
+        [&]() { return SolvePart1( inputData ); },
+        [&]() { return SolvePart2( inputData ); },
+        glbExecMode == CONCURRENT
+    );
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1: " );   // =========================^^^^^vvvvv
+    ReportPart( DAY_STRING, 1, results.first  );
+    ReportPart( DAY_STRING, 2, results.second );
 
-    inputData = part2Data; // get fresh untouched copy of input data
+/* ========== */   tmr.TimeReport( "    Timing 1 + 2 - wall clock time both parts: " );   // =====================^^^^^vvvvv
 
-    // part 2 code here
-    nDialValue = 50;
-    nZeros = 0;
-//    std::cout << "the dial starts by pointing at: " << nDialValue << ", nr of zeros = " << nZeros << std::endl;
-
-
-    for (int i = 0; i < (int)inputData.size(); i++) {
-        int nDiv = my_div( inputData[i].nr, 100 );
-        int nNewValue = my_mod( nDialValue + inputData[i].nr, 100 );
-
-        // the case of the dial value being zero is tested separately, so exclude it from
-        // the test for "going through" zero
-        if (inputData[i].nr < 0) {                          // rotate dial to left
-            if (nNewValue > nDialValue && nDialValue > 0) {
-                nZeros += 1;
-            }
-        } else {                                            // rotate dial to right
-            if (nNewValue < nDialValue && nNewValue != 0) {
-                nZeros += 1;
-            }
-        }
-
-        if (nNewValue == 0) {
-            nZeros += 1;
-        }
-        nZeros += nDiv;
-        nDialValue = nNewValue;
-
-//        std::cout << "the dial is rotated: ";
-//        PrintDatum( inputData[i], false );
-//        std::cout << " to point at: " << nDialValue << ", nr of zeros = " << nZeros<< std::endl;
+    // get the answers for all starting positions in one pass, and check them against the start at 50
+    std::vector<long long> vAllPart1, vAllPart2;
+    ScanAllStarts( inputData, vAllPart1, vAllPart2 );
+    if (vAllPart1[50] != results.first.answer || vAllPart2[50] != results.second.answer) {
+        std::cout << "ERROR: main() --> all starting positions scan differs from part 1 and 2 answers" << std::endl;
     }
+//    for (int s = 0; s < 100; s++) {
+//        std::cout << "start: " << s << " part 1: " << vAllPart1[s] << " part 2: " << vAllPart2[s] << std::endl;
+//    }
 
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 2 = " << nZeros << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2: " );   // ==============================^^^^^
+/* ========== */   tmr.TimeReport( "    Timing 3 - all starting positions: " );   // ==============================^^^^^
 
     return 0;
 }
@@ -11,10 +11,13 @@
 #include <algorithm>
 #include <numeric>
 #include <vector>
+#include <cstdio>
 
 #include "../flcTimer.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
+#include "run_parts.h"                 // used for running both parts concurrently
+#include "thread_pool.h"               // used for parallel loops
 
 // ==========   PROGRAM STAGING
 
@@ -33,6 +36,11 @@ std::string ProgPhase2string() {
     return "unknown";
 }
 
+enum eExecMode {      // how to run the two parts - set at start of main()
+    SEQUENTIAL = 0,   //    1. solve part 1 first, then part 2
+    CONCURRENT        //    2. solve part 1 and part 2 as parallel tasks, and join them before reporting
+} glbExecMode;
+
 // ==========   INPUT DATA STRUCTURES          <<===== adapt to match columns of input file
 
 // the data consists of tuples (pairs) of numbers
@@ -121,65 +129,381 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 
 // ==========   PUZZLE SPECIFIC SOLUTIONS
 
-// ----- PART 1
+// ----- REPEATED BLOCK ENUMERATION (used by both parts)
+
+/*
+ * Instead of checking every id in a range, the invalid id's are generated directly. An id of L digits
+ * that consists of a block of b digits repeated k = L / b times is B * R, where B is the block value
+ * (b digits, no leading zero) and R = (10^L - 1) / (10^b - 1) is the "repunit" 1 0..0 1 0..0 1 with
+ * k ones. So the invalid id's in [ lo, hi ] for one (L, b) are R * B for B in an interval, and their
+ * sum is R times an arithmetic series.
+ *
+ * For part 2 a number like 222222 is a repetition for b = 1, 2 and 3, but must be counted only once.
+ * A repetition for block length b is also one for every multiple of b that divides L, so the union
+ * over all b is the union over b = L / p for the primes p dividing L. Inclusion-exclusion over those
+ * primes gives: sum over squarefree d > 1 dividing L of -mu( d ) * S( L / d ), with mu the Moebius
+ * function and S( b ) the sum for block length b.
+ */
+
+// nr of digits of the largest id that fits in a long long
+#define MAX_ID_DIGITS  19
+
+typedef __int128 BigIntType;
+
+// returns 10^n as a 128 bit integer
+BigIntType Pow10( int n ) {
+    BigIntType result = 1;
+    for (int i = 0; i < n; i++) {
+        result *= 10;
+    }
+    return result;
+}
 
-// An id is NOT valid IFF
-//   1. it's length is an even number, and
-//   2. it's two halves are identical
-bool IsValid( long long id ) {
-    bool bResult = true;               // assume valid until proven otherwise
-    std::string sId = to_string( id );
-    int sLen = sId.length();
-    if (sLen % 2 == 0) {
-        // split string in two parts
-        std::string sLeft, sRght;
-        split_token_sized( sLen / 2, sId, sLeft, sRght );
-        if (sLeft == sRght) {
-            bResult = false;
+// returns the Moebius function of d: 0 if d has a squared prime factor, else (-1)^(nr of prime factors)
+int Moebius( int d ) {
+    int nResult = 1;
+    for (int p = 2; p * p <= d; p++) {
+        if (d % p == 0) {
+            d /= p;
+            if (d % p == 0) {
+                return 0;
+            }
+            nResult = -nResult;
         }
     }
-    return bResult;
+    return d > 1 ? -nResult : nResult;
 }
 
-// ----- PART 2
+// returns the sum of all id's of nLen digits in [ lo, hi ] that consist of a block of nBlock digits
+// repeated nLen / nBlock times - ASSUMPTION: lo and hi both have nLen digits, and nBlock divides nLen
+BigIntType SumBlockRepeats( BigIntType lo, BigIntType hi, int nLen, int nBlock ) {
+    BigIntType R = (Pow10( nLen ) - 1) / (Pow10( nBlock ) - 1);
+    BigIntType bMin = std::max( Pow10( nBlock - 1 ), (lo + R - 1) / R );
+    BigIntType bMax = std::min( Pow10( nBlock ) - 1,  hi          / R );
+    if (bMin > bMax) {
+        return 0;
+    }
+    return R * ((bMin + bMax) * (bMax - bMin + 1) / 2);
+}
 
-// checks validity of the id that is passed as a token, and a divisor value nPartLen
-// ASSUMPTION: nPartLen must indeed be a divisor of the length of sID
-bool CheckCase( std::string sID, int nPartLen ) {
-    bool bValid = false;    // assume IN-valid until proven otherwise
-
-    // get the pieces of sID into a std::vector
-    std::vector<std::string> vTokens;
-    int nParts = sID.length() / nPartLen;
-    for (int i = 0; i < nParts; i++) {
-        std::string s = get_token_sized( nPartLen, sID );
-        vTokens.push_back( s );
-    }
-    // check pieces pairwise against each other
-    bool bIdentical = true;
-    for (int i = 0; i < nParts - 1 && bIdentical; i++) {
-        bIdentical = (vTokens[i] == vTokens[i + 1]);
-    }
-    // sID is invalid if all the pieces are identical
-    bValid = !bIdentical;
-    return bValid;
-}
-
-// Brute for through all possible part lengths of id. If id can be split into
-// multiple pieces without a remainder, we found a divisor, and use
-// CheckCase() for checking that situation
-bool IsValid2( long long id ) {
-    bool bValid = true;                 // assume valid until proven otherwise
-    std::string sId = to_string( id );
-    int sLen = sId.length();
-    for (int i = sLen - 1; i > 0 && bValid; i--) {
-        // check case only if i is a divisor of sLen
-        if (sLen % i == 0) {
-            std::string sCopy = sId; // the parameter is altered, so use a copy
-            bValid = CheckCase( sCopy, i );
+// returns the sum of the invalid id's in range [ id1, id2 ]. If bTwoRepeatsOnly is true, only blocks
+// that are repeated exactly twice count (part 1), otherwise any nr of repeats >= 2 counts (part 2)
+BigIntType SumRepeatedInRange( long long id1, long long id2, bool bTwoRepeatsOnly ) {
+    BigIntType result = 0;
+    for (int nLen = 2; nLen <= MAX_ID_DIGITS; nLen++) {
+        // clip the range to the id's that have nLen digits
+        BigIntType lo = std::max( (BigIntType)id1, Pow10( nLen - 1 )     );
+        BigIntType hi = std::min( (BigIntType)id2, Pow10( nLen     ) - 1 );
+        if (lo > hi) {
+            continue;
+        }
+        if (bTwoRepeatsOnly) {
+            if (nLen % 2 == 0) {
+                result += SumBlockRepeats( lo, hi, nLen, nLen / 2 );
+            }
+        } else {
+            // inclusion-exclusion over the squarefree divisors d > 1 of nLen
+            for (int d = 2; d <= nLen; d++) {
+                int nMu = (nLen % d == 0) ? Moebius( d ) : 0;
+                if (nMu != 0) {
+                    result -= nMu * SumBlockRepeats( lo, hi, nLen, nLen / d );
+                }
+            }
         }
     }
-    return bValid;
+    return result;
+}
+
+// returns the sum of the invalid id's over all ranges in dData
+long long SumRepeatedIds( const DataStream &dData, bool bTwoRepeatsOnly ) {
+    BigIntType result = 0;
+    for (auto &d : dData) {
+        result += SumRepeatedInRange( d.id1, d.id2, bTwoRepeatsOnly );
+    }
+    return (long long)result;
+}
+
+// ----- INVALID ID INDEX (for answering many range queries)
+
+/*
+ * When many range lists have to be processed, the invalid id's can be tabulated once: a sorted table
+ * of all invalid id's up to nMaxDigits digits, together with the prefix sums over that table. The sum
+ * of the invalid id's in [ id1, id2 ] is then the difference of two prefix sums, found with two binary
+ * searches. The table can be saved to and loaded from a binary file.
+ *
+ * NOTE: tabulating up to the full 64 bit range is not feasible - for 18 digits alone there are about
+ * 10^9 invalid id's. The index is therefore built up to a digit limit (default 12 digits, about 10^6
+ * entries), and the part of a range beyond that limit is handled by the enumerator above.
+ */
+
+#define INDEX_MAX_DIGITS  12
+
+// largest digit limit an index can have - all id's of up to 18 digits fit in a long long
+#define INDEX_LIMIT_DIGITS  (MAX_ID_DIGITS - 1)
+
+typedef struct {
+    bool                    bTwoRepeatsOnly;   // true: part 1 rule, false: part 2 rule
+    int                     nMaxDigits;        // all invalid id's with up to this many digits are in the table
+    std::vector<long long>  vIds;              // sorted invalid id's
+    std::vector<BigIntType> vPrefix;           // vPrefix[i] = sum of vIds[0] .. vIds[i - 1]
+} IdIndexType;
+
+// (re)creates the prefix sums of index from its table of id's
+void CreatePrefixSums( IdIndexType &index ) {
+    index.vPrefix.assign( index.vIds.size() + 1, 0 );
+    for (int i = 0; i < (int)index.vIds.size(); i++) {
+        index.vPrefix[i + 1] = index.vPrefix[i] + index.vIds[i];
+    }
+}
+
+// builds an index of all invalid id's up to nMaxDigits digits, for the part 1 or part 2 rule
+IdIndexType BuildIdIndex( bool bTwoRepeatsOnly, int nMaxDigits = INDEX_MAX_DIGITS ) {
+    IdIndexType index;
+    index.bTwoRepeatsOnly = bTwoRepeatsOnly;
+    index.nMaxDigits = std::max( 1, std::min( nMaxDigits, INDEX_LIMIT_DIGITS ));
+    for (int nLen = 2; nLen <= index.nMaxDigits; nLen++) {
+        for (int nBlock = 1; nBlock < nLen; nBlock++) {
+            if (nLen % nBlock != 0 || (bTwoRepeatsOnly && nLen != 2 * nBlock)) {
+                continue;
+            }
+            long long R = (long long)((Pow10( nLen ) - 1) / (Pow10( nBlock ) - 1));
+            for (long long B = (long long)Pow10( nBlock - 1 ); B < (long long)Pow10( nBlock ); B++) {
+                index.vIds.push_back( B * R );
+            }
+        }
+    }
+    // id's that are a repetition for multiple block lengths must appear only once
+    std::sort( index.vIds.begin(), index.vIds.end());
+    index.vIds.erase( std::unique( index.vIds.begin(), index.vIds.end()), index.vIds.end());
+    CreatePrefixSums( index );
+    return index;
+}
+
+// writes the index to a binary file - returns false if that failed
+bool SaveIdIndex( const IdIndexType &index, const std::string &sFileName ) {
+    std::ofstream outFile( sFileName, std::ios::binary );
+    char cTwoRepeatsOnly = index.bTwoRepeatsOnly ? 1 : 0;
+    long long nSize = index.vIds.size();
+    outFile.write( (const char *)&cTwoRepeatsOnly      , sizeof( cTwoRepeatsOnly       ));
+    outFile.write( (const char *)&index.nMaxDigits     , sizeof( index.nMaxDigits      ));
+    outFile.write( (const char *)&nSize                , sizeof( nSize                 ));
+    outFile.write( (const char *)index.vIds.data()     , nSize * sizeof( long long     ));
+    return outFile.good();
+}
+
+// Reads the index from a binary file - returns false if that failed, or if the file content is not a
+// valid index (rule flag not 0 or 1, digit limit out of range, size not matching the file length, or
+// id's not sorted)
+bool LoadIdIndex( IdIndexType &index, const std::string &sFileName ) {
+    std::ifstream inFile( sFileName, std::ios::binary );
+    char cTwoRepeatsOnly = 0;
+    long long nSize = 0;
+    inFile.read( (char *)&cTwoRepeatsOnly      , sizeof( cTwoRepeatsOnly       ));
+    inFile.read( (char *)&index.nMaxDigits     , sizeof( index.nMaxDigits      ));
+    inFile.read( (char *)&nSize                , sizeof( nSize                 ));
+    if (!inFile.good() || (cTwoRepeatsOnly != 0 && cTwoRepeatsOnly != 1) ||
+        index.nMaxDigits < 1 || index.nMaxDigits > INDEX_LIMIT_DIGITS) {
+        return false;
+    }
+    index.bTwoRepeatsOnly = (cTwoRepeatsOnly == 1);
+    // the id's must fill exactly the rest of the file
+    std::streampos nPos = inFile.tellg();
+    inFile.seekg( 0, std::ios::end );
+    long long llRemaining = (long long)(inFile.tellg() - nPos);
+    inFile.seekg( nPos );
+    if (nSize < 0 || llRemaining != nSize * (long long)sizeof( long long )) {
+        return false;
+    }
+    index.vIds.resize( nSize );
+    inFile.read( (char *)index.vIds.data(), nSize * sizeof( long long ));
+    if (!inFile.good() || !std::is_sorted( index.vIds.begin(), index.vIds.end())) {
+        return false;
+    }
+    CreatePrefixSums( index );
+    return true;
+}
+
+// returns the sum of the invalid id's in [ id1, id2 ] using index, and the enumerator
+// for the part of the range that is beyond the digit limit of the index
+BigIntType QueryIdIndex( const IdIndexType &index, long long id1, long long id2 ) {
+    BigIntType result = 0;
+    long long llLimit = (long long)Pow10( index.nMaxDigits ) - 1;
+    if (id1 <= llLimit) {
+        long long hi = std::min( id2, llLimit );
+        int nIx1 = std::lower_bound( index.vIds.begin(), index.vIds.end(), id1 ) - index.vIds.begin();
+        int nIx2 = std::upper_bound( index.vIds.begin(), index.vIds.end(), hi  ) - index.vIds.begin();
+        if (nIx1 < nIx2) {
+            result += index.vPrefix[nIx2] - index.vPrefix[nIx1];
+        }
+    }
+    if (id2 > llLimit) {
+        result += SumRepeatedInRange( std::max( id1, llLimit + 1 ), id2, index.bTwoRepeatsOnly );
+    }
+    return result;
+}
+
+// returns the sum of the invalid id's over all ranges in dData using index
+long long QueryIdIndex( const IdIndexType &index, const DataStream &dData ) {
+    BigIntType result = 0;
+    for (auto &d : dData) {
+        result += QueryIdIndex( index, d.id1, d.id2 );
+    }
+    return (long long)result;
+}
+
+// ----- BRUTE FORCE CHECKER (used in main() to check the enumerator)
+
+/*
+ * The brute force approach checks every id in a range. An id of L digits is a block of b digits
+ * repeated L / b times, if and only if it is divisible by the repunit R = (10^L - 1) / (10^b - 1) - the
+ * quotient then automatically has b digits. Repunits are odd, so they have an inverse modulo 2^64, and
+ * n is divisible by R exactly when n * inverse( R ) (mod 2^64) <= (2^64 - 1) / R. This avoids both
+ * strings and divisions.
+ *
+ * For part 1 only b = L / 2 is checked. For part 2 it suffices to check the largest proper divisors
+ * b = L / p of L, for the (at most two, since L <= 19) distinct primes p that divide L.
+ *
+ * The ids are checked in batches of ID_BATCH, using fixed size loops over the lanes of the batch
+ * without branches or allocations, so that the compiler can vectorise them.
+ */
+
+typedef unsigned long long u64;
+
+#define ID_BATCH  8    // nr of id's that is checked per call
+
+// divisibility test for one repunit: n is divisible if n * inverse <= limit
+typedef struct {
+    u64 inverse;
+    u64 limit;
+} DivTestType;
+
+typedef struct {
+    u64         vPow10[MAX_ID_DIGITS + 1];       // 10^0 .. 10^19
+    DivTestType vPart1[MAX_ID_DIGITS + 1];       // per nr of digits: test for two repeats
+    DivTestType vPart2[MAX_ID_DIGITS + 1][2];    // per nr of digits: tests for the largest proper divisors
+} DigitTablesType;
+
+// returns the test for divisibility by the repunit of nLen digits with blocks of nBlock digits
+constexpr DivTestType MakeDivTest( const u64 *vPow10, int nLen, int nBlock ) {
+    u64 R = 0;
+    for (int i = 0; i < nLen; i += nBlock) {
+        R += vPow10[i];
+    }
+    // Newton iteration for the inverse modulo 2^64 - each step doubles the nr of correct bits
+    u64 inv = R;
+    for (int i = 0; i < 5; i++) {
+        inv *= 2 - R * inv;
+    }
+    return { inv, ~0ULL / R };
+}
+
+constexpr DigitTablesType MakeDigitTables() {
+    DigitTablesType t = {};
+    t.vPow10[0] = 1;
+    for (int i = 1; i <= MAX_ID_DIGITS; i++) {
+        t.vPow10[i] = t.vPow10[i - 1] * 10;
+    }
+    // tests that are not applicable never match any id > 0
+    for (int nLen = 0; nLen <= MAX_ID_DIGITS; nLen++) {
+        t.vPart1[nLen] = t.vPart2[nLen][0] = t.vPart2[nLen][1] = { 1, 0 };
+    }
+    for (int nLen = 2; nLen <= MAX_ID_DIGITS; nLen++) {
+        if (nLen % 2 == 0) {
+            t.vPart1[nLen] = MakeDivTest( t.vPow10, nLen, nLen / 2 );
+        }
+        int nSlot = 0, nRest = nLen;
+        for (int p = 2; p <= nRest; p++) {
+            if (nRest % p == 0) {
+                t.vPart2[nLen][nSlot++] = MakeDivTest( t.vPow10, nLen, nLen / p );
+                while (nRest % p == 0) { nRest /= p; }
+            }
+        }
+    }
+    return t;
+}
+
+constexpr DigitTablesType glbDigitTables = MakeDigitTables();
+
+// returns the nr of digits of n (0 has 1 digit)
+inline int NrDigits( u64 n ) {
+    int nResult = 1;
+    for (int i = 1; i <= MAX_ID_DIGITS; i++) {
+        nResult += (n >= glbDigitTables.vPow10[i]) ? 1 : 0;
+    }
+    return nResult;
+}
+
+inline bool PassesTest( u64 n, const DivTestType &t ) {
+    return n * t.inverse <= t.limit;
+}
+
+// Checks ID_BATCH id's at once. Sets vInvalid[i] to true if vIds[i] is a repeated block id - using the
+// part 1 rule if bTwoRepeatsOnly is true, the part 2 rule otherwise
+void CheckIdBatch( const u64 *vIds, bool bTwoRepeatsOnly, bool *vInvalid ) {
+    int vLen[ID_BATCH];
+    for (int i = 0; i < ID_BATCH; i++) {
+        vLen[i] = NrDigits( vIds[i] );
+    }
+    if (bTwoRepeatsOnly) {
+        for (int i = 0; i < ID_BATCH; i++) {
+            vInvalid[i] = PassesTest( vIds[i], glbDigitTables.vPart1[vLen[i]] );
+        }
+    } else {
+        for (int i = 0; i < ID_BATCH; i++) {
+            vInvalid[i] = PassesTest( vIds[i], glbDigitTables.vPart2[vLen[i]][0] ) |
+                          PassesTest( vIds[i], glbDigitTables.vPart2[vLen[i]][1] );
+        }
+    }
+}
+
+// nr of id's per parallel task - fixed, so that the chunking doesn't depend on the nr of cores
+#define ID_GRAIN  4096
+
+// sums all invalid id's in the ranges of dData by checking each of them (using the part 1 rule
+// if bTwoRepeatsOnly is true) - the id's of each range are checked in parallel chunks
+long long SumInvalidIds( const DataStream &dData, bool bTwoRepeatsOnly ) {
+    long long llResult = 0;
+
+    for (int i = 0; i < (int)dData.size(); i++) {
+        // process the range for one input datum
+        const DatumType &d = dData[i];
+        llResult += ParallelReduce(
+            d.id1, d.id2 + 1, 0LL,
+            [bTwoRepeatsOnly]( long long lo, long long hi ) {
+                long long llPartial = 0;
+                u64  vIds[ID_BATCH];
+                bool vInvalid[ID_BATCH];
+                for (long long j = lo; j < hi; j += ID_BATCH) {
+                    // the last batch is padded with 0's - a 0 may pass the repeated digit test, but it adds nothing to the sum
+                    for (int k = 0; k < ID_BATCH; k++) {
+                        vIds[k] = (j + k < hi) ? j + k : 0;
+                    }
+                    CheckIdBatch( vIds, bTwoRepeatsOnly, vInvalid );
+                    for (int k = 0; k < ID_BATCH; k++) {
+                        llPartial += vInvalid[k] ? vIds[k] : 0;
+                    }
+                }
+                return llPartial;
+            },
+            []( long long a, long long b ) { return a + b; },
+            ID_GRAIN
+        );
+    }
+    return llResult;
+}
+
+// ----- PART 1
+
+// solves part 1: sum all invalid id's in the ranges of the input data
+long long SolvePart1( const DataStream &inputData ) {
+    return SumRepeatedIds( inputData, true );
+}
+
+// ----- PART 2
+
+// solves part 2: like part 1, but a block may be repeated any nr of times
+long long SolvePart2( const DataStream &inputData ) {
+    return SumRepeatedIds( inputData, false );
 }
 
 // ==========   MAIN()
@@ -187,54 +511,59 @@ bool IsValid2( long long id ) {
 int main()
 {
     glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    glbExecMode = CONCURRENT;  // execution mode SEQUENTIAL or CONCURRENT
     std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
     flcTimer tmr;
 
 /* ========== */   tmr.StartTiming();   // ============================================vvvvv
 
     // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream inputData;
-    GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
+    DataStream parsedData;
+    GetInput( parsedData, glbProgPhase != PUZZLE );
+    // both parts only read the input data, so they share it instead of each working on a copy
+    const DataStream &inputData = parsedData;
     std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
 
 /* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
 
-    // part 1 code here
-    long long llResult = 0;
-
-    for (int i = 0; i < (int)inputData.size(); i++) {
-        // process the range for one input datum
-        DatumType d = inputData[i];
-        for (long long j = d.id1; j <= d.id2; j++) {
-            if (!IsValid( j )) {
-                llResult += j;
-            }
-        }
-    }
+    // solve both parts, sequentially or concurrently depending on glbExecMode
+    auto results = RunParts(
+        [&]() { return SolvePart1( inputData ); },
+        [&]() { return SolvePart2( inputData ); },
+        glbExecMode == CONCURRENT
+    );
 
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 1: " << llResult << std::endl << std::endl;
+    ReportPart( DAY_STRING, 1, results.first  );
+    ReportPart( DAY_STRING, 2, results.second );
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1: " );   // =========================^^^^^vvvvv
+/* ========== */   tmr.TimeReport( "    Timing 1 + 2 - wall clock time both parts: " );   // =====================^^^^^vvvvv
 
-    inputData = part2Data; // get fresh untouched copy of input data
+    // check the enumerator answers by checking every id with the batched checker
+    if (SumInvalidIds( inputData, true ) != results.first.answer || SumInvalidIds( inputData, false ) != results.second.answer) {
+        std::cout << "ERROR: main() --> batched id checker results differ from part 1 and 2 answers" << std::endl;
+    }
 
-    // part 2 code here
-    llResult = 0;
+/* ========== */   tmr.TimeReport( "    Timing 3 - batched id checker: " );   // ===================================^^^^^vvvvv
 
-    for (int i = 0; i < (int)inputData.size(); i++) {
-        // process the range for one input datum
-        DatumType d = inputData[i];
-        for (long long j = d.id1; j <= d.id2; j++) {
-            if (!IsValid2( j )) {
-                llResult += j;
-            }
-        }
+    // build the invalid id indices for both rules, and check them against the answers of both parts
+    IdIndexType index1 = BuildIdIndex( true  );
+    IdIndexType index2 = BuildIdIndex( false );
+    if (QueryIdIndex( index1, inputData ) != results.first.answer || QueryIdIndex( index2, inputData ) != results.second.answer) {
+        std::cout << "ERROR: main() --> invalid id index results differ from part 1 and 2 answers" << std::endl;
     }
+    // persist the part 2 index, and check that it reads back the same
+    IdIndexType indexLoaded;
+    std::string sIndexFile = std::string( DAY_STRING ) + ".index.part2.bin";
+    if (!SaveIdIndex( index2, sIndexFile ) || !LoadIdIndex( indexLoaded, sIndexFile ) ||
+        indexLoaded.bTwoRepeatsOnly != index2.bTwoRepeatsOnly || indexLoaded.nMaxDigits != index2.nMaxDigits ||
+        indexLoaded.vIds != index2.vIds || QueryIdIndex( indexLoaded, inputData ) != results.second.answer) {
+        std::cout << "ERROR: main() --> saved and loaded invalid id index differs from the built one" << std::endl;
+    }
+    std::remove( sIndexFile.c_str());
+    std::cout << "Index stats - nr of invalid id's in part 1 index " << index1.vIds.size()
+              <<                           " and in part 2 index " << index2.vIds.size() << std::endl << std::endl;
 
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 2: " << llResult << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2: " );   // ==============================^^^^^
+/* ========== */   tmr.TimeReport( "    Timing 4 - building, saving and querying invalid id index: " );   // =================^^^^^
 
     return 0;
 }
@@ -11,11 +11,12 @@
 #include <algorithm>
 #include <numeric>
 #include <vector>
-#include <set>
 
 #include "../flcTimer.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
+#include "run_parts.h"                 // used for running both parts concurrently
+#include "cellular_automaton.h"        // used for the generic version of the removal rounds
 
 #include "vector_types.h"            // used for modeling coordinates
 
@@ -36,6 +37,11 @@ std::string ProgPhase2string() {
     return "unknown";
 }
 
+enum eExecMode {      // how to run the two parts - set at start of main()
+    SEQUENTIAL = 0,   //    1. solve part 1 first, then part 2
+    CONCURRENT        //    2. solve part 1 and part 2 as parallel tasks, and join them before reporting
+} glbExecMode;
+
 // ==========   INPUT DATA STRUCTURES          <<===== adapt to match columns of input file
 
 // the data consists of a grid, modelled as a std::vector of std::string
@@ -117,120 +123,241 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 
 // ==========   PUZZLE SPECIFIC SOLUTIONS
 
-// ----- PART 1
+// The input grid is shared read only by both parts. Part 2 removes paper rolls, so it works on its
+// own copy of the bitboard below, instead of on the grid itself.
+
+// ----- BITBOARD (used by both parts)
+
+/*
+ * The grid is also kept as a bitboard: one bit per cell, 64 cells per word, a whole nr of words per
+ * row. The nr of neighbouring rolls is then computed for 64 cells at once: the 8 neighbour bit masks
+ * are obtained by shifting the row above, the row itself and the row below one position left and right,
+ * and are added with bit sliced adders into a 4 bit counter per cell (c0 .. c3, the count is at most 8).
+ * A count below 4 means that bits c2 and c3 are both 0.
+ */
+
+typedef unsigned long long u64;
+
+typedef struct {
+    int nWidth, nHeight;
+    int nWords;                  // nr of 64 bit words per row
+    std::vector<u64> vBits;      // nHeight * nWords words, bit x % 64 of word x / 64 is cell x
+} BitGridType;
+
+// creates a bitboard of the paper rolls in grid dData
+BitGridType CreateBitGrid( const DataStream &dData ) {
+    BitGridType g;
+    g.nHeight = dData.size();
+    g.nWidth  = dData[0].length();
+    g.nWords  = (g.nWidth + 63) / 64;
+    g.vBits.assign( g.nHeight * g.nWords, 0 );
+    for (int y = 0; y < g.nHeight; y++) {
+        for (int x = 0; x < g.nWidth; x++) {
+            if (dData[y][x] == '@') {
+                g.vBits[y * g.nWords + x / 64] |= 1ULL << (x % 64);
+            }
+        }
+    }
+    return g;
+}
 
-// returns true if the coordinate pair (x, y) is not in bounds of the grid dData
-bool IsOutOfBounds( DataStream &dData, int x, int y ) {
-    if (x < 0 || x >= (int)dData[0].length()) { return true; }
-    if (y < 0 || y >= (int)dData.size()) {      return true; }
-    return false;
+// returns word w of row y, or 0 if (y, w) is outside the bitboard
+inline u64 GetWord( const BitGridType &g, int y, int w ) {
+    if (y < 0 || y >= g.nHeight || w < 0 || w >= g.nWords) return 0;
+    return g.vBits[y * g.nWords + w];
 }
 
-// returns true if out of bounds or '.' in the grid at (x, y)
-bool IsEmpty( DataStream &dData, int x, int y ) {
-    if (IsOutOfBounds( dData, x, y )) return true;
-    return dData[y][x] == '.';
+// adds the bit mask x to the bit sliced counter (c0 .. c3)
+inline void AddToCounter( u64 x, u64 &c0, u64 &c1, u64 &c2, u64 &c3 ) {
+    u64 k0 = c0 & x;  c0 ^= x;
+    u64 k1 = c1 & k0; c1 ^= k0;
+    u64 k2 = c2 & k1; c2 ^= k1;
+    c3 |= k2;
 }
 
-// returns true if in bounds and '@' in the grid at (x, y)
-bool IsRoll( DataStream &dData, int x, int y ) {
-    if (IsOutOfBounds( dData, x, y )) return false;
-    return dData[y][x] == '@';
+// adds the cells of row y of word w, and their left and right neighbours, to the counter
+// if bSkipSelf is true the cells themselves are not added (only their left and right neighbours)
+inline void AddRowToCounter( const BitGridType &g, int y, int w, bool bSkipSelf, u64 &c0, u64 &c1, u64 &c2, u64 &c3 ) {
+    u64 nPrev = GetWord( g, y, w - 1 );
+    u64 nCur  = GetWord( g, y, w     );
+    u64 nNext = GetWord( g, y, w + 1 );
+    AddToCounter( (nCur << 1) | (nPrev >> 63), c0, c1, c2, c3 );    // neighbour at x - 1
+    AddToCounter( (nCur >> 1) | (nNext << 63), c0, c1, c2, c3 );    // neighbour at x + 1
+    if (!bSkipSelf) {
+        AddToCounter( nCur, c0, c1, c2, c3 );                       // neighbour at x
+    }
 }
 
-// accumulate and return the number of neighbours that is a paper roll
-int NrNeighbourRolls( DataStream &dData, int x, int y ) {
-    int nOccupied = 0;
-    if (IsRoll( dData, x - 1, y - 1 )) nOccupied += 1;
-    if (IsRoll( dData, x    , y - 1 )) nOccupied += 1;
-    if (IsRoll( dData, x + 1, y - 1 )) nOccupied += 1;
-    if (IsRoll( dData, x - 1, y     )) nOccupied += 1;
-    if (IsRoll( dData, x + 1, y     )) nOccupied += 1;
-    if (IsRoll( dData, x - 1, y + 1 )) nOccupied += 1;
-    if (IsRoll( dData, x    , y + 1 )) nOccupied += 1;
-    if (IsRoll( dData, x + 1, y + 1 )) nOccupied += 1;
-    return nOccupied;
+// sets the counter (c0 .. c3) to the nr of neighbouring rolls of the 64 cells in word w of row y
+inline void GetNeighbourCounter( const BitGridType &g, int y, int w, u64 &c0, u64 &c1, u64 &c2, u64 &c3 ) {
+    c0 = 0; c1 = 0; c2 = 0; c3 = 0;
+    AddRowToCounter( g, y - 1, w, false, c0, c1, c2, c3 );
+    AddRowToCounter( g, y    , w, true , c0, c1, c2, c3 );
+    AddRowToCounter( g, y + 1, w, false, c0, c1, c2, c3 );
 }
 
-// a paper roll can be moved/processed/worked on if has less than 4 neighbouring rolls (in 8-connected grid)
-bool IsWorkable( DataStream &dData, int x, int y ) {
-    return IsRoll( dData, x, y ) && (NrNeighbourRolls( dData, x, y ) < 4);
+// returns the mask of rolls in word w of row y that have less than 4 neighbouring rolls
+u64 WorkableMask( const BitGridType &g, int y, int w ) {
+    u64 c0, c1, c2, c3;
+    GetNeighbourCounter( g, y, w, c0, c1, c2, c3 );
+    return GetWord( g, y, w ) & ~(c2 | c3);
 }
 
-// use a std::set to get the unique positions for the paper rolls that are workable
-std::set<vi2d> GetRollPositions( DataStream &dData ) {
-    std::set<vi2d> sResult;
+// fills vMask with the workable rolls of bitboard g (same layout as g.vBits), and returns their nr
+int GetWorkableMasks( const BitGridType &g, std::vector<u64> &vMask ) {
+    int nCount = 0;
+    vMask.assign( g.vBits.size(), 0 );
+    for (int y = 0; y < g.nHeight; y++) {
+        for (int w = 0; w < g.nWords; w++) {
+            vMask[y * g.nWords + w] = WorkableMask( g, y, w );
+            nCount += __builtin_popcountll( vMask[y * g.nWords + w] );
+        }
+    }
+    return nCount;
+}
 
-    for (int y = 0; y < (int)dData.size(); y++) {
-        for (int x = 0; x < (int)dData[0].length(); x++) {
-            if (IsWorkable( dData, x, y )) {
-                sResult.insert( vi2d( x, y ));
+// ----- PART 1
+
+// solves part 1: count the paper rolls that are workable, using the bitboard of the input grid
+int SolvePart1( const DataStream &inputData ) {
+    BitGridType bitGrid = CreateBitGrid( inputData );
+    std::vector<u64> vWorkable;
+    return GetWorkableMasks( bitGrid, vWorkable );
+}
+
+// ----- PART 2
+
+/*
+ * Instead of rescanning the whole grid for every round of removals, the neighbour counts are computed
+ * once (from the bitboard counters), and the removable rolls are kept in a work list. Removing a roll
+ * clears its bit and decrements the counts of its neighbouring rolls, and a neighbour that drops below 4
+ * becomes removable and is put on the list. The end result doesn't depend on the order of removal, so
+ * this gives the same answer as doing it in rounds, but each roll is processed only once.
+ */
+
+typedef std::vector<unsigned char> CountGridType;    // nHeight * nWidth counts, row major
+
+// returns true if cell (x, y) of bitboard g holds a roll (false if out of bounds)
+inline bool IsRollBit( const BitGridType &g, int x, int y ) {
+    if (x < 0 || x >= g.nWidth || y < 0 || y >= g.nHeight) return false;
+    return (g.vBits[y * g.nWords + x / 64] >> (x % 64)) & 1;
+}
+
+// returns the nr of neighbouring rolls for each roll of bitboard g (the counts of empty cells are 0)
+CountGridType GetNeighbourCounts( const BitGridType &g ) {
+    CountGridType vCounts( g.nHeight * g.nWidth, 0 );
+    for (int y = 0; y < g.nHeight; y++) {
+        for (int w = 0; w < g.nWords; w++) {
+            u64 c0, c1, c2, c3;
+            GetNeighbourCounter( g, y, w, c0, c1, c2, c3 );
+            // read the counter bits of each roll in this word
+            for (u64 nRolls = GetWord( g, y, w ); nRolls != 0; nRolls &= nRolls - 1) {
+                int b = __builtin_ctzll( nRolls );
+                vCounts[y * g.nWidth + w * 64 + b] = ((c0 >> b) & 1) | (((c1 >> b) & 1) << 1) |
+                                                     (((c2 >> b) & 1) << 2) | (((c3 >> b) & 1) << 3);
             }
         }
     }
-    return sResult;
+    return vCounts;
 }
 
-// ----- PART 2
+// Counts the paper rolls that can be removed by repeatedly removing the workable ones, using a work
+// list on the bitboard. The bitboard is passed by value, since it's altered: a roll's bit is cleared
+// as soon as it's on the work list.
+int PeelWorkList( BitGridType g ) {
+    CountGridType vCounts = GetNeighbourCounts( g );
+
+    // initially all workable rolls are removable
+    std::vector<u64> vWorkable;
+    GetWorkableMasks( g, vWorkable );
+    std::vector<int> vWorkList;
+    for (int y = 0; y < g.nHeight; y++) {
+        for (int w = 0; w < g.nWords; w++) {
+            for (u64 nMask = vWorkable[y * g.nWords + w]; nMask != 0; nMask &= nMask - 1) {
+                vWorkList.push_back( y * g.nWidth + w * 64 + __builtin_ctzll( nMask ));
+            }
+            g.vBits[y * g.nWords + w] &= ~vWorkable[y * g.nWords + w];
+        }
+    }
+    int nTotalRemoved = vWorkList.size();
+
+    // remove the rolls on the work list one by one, and add the neighbours that become workable
+    while (!vWorkList.empty()) {
+        int x = vWorkList.back() % g.nWidth, y = vWorkList.back() / g.nWidth;
+        vWorkList.pop_back();
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int nx = x + dx, ny = y + dy;
+                if ((dx != 0 || dy != 0) && IsRollBit( g, nx, ny )) {
+                    vCounts[ny * g.nWidth + nx] -= 1;
+                    if (vCounts[ny * g.nWidth + nx] < 4) {
+                        g.vBits[ny * g.nWords + nx / 64] &= ~(1ULL << (nx % 64));
+                        vWorkList.push_back( ny * g.nWidth + nx );
+                        nTotalRemoved += 1;
+                    }
+                }
+            }
+        }
+    }
+    return nTotalRemoved;
+}
 
-// no additional functions needed - solution for part 2 is coded directly from the functions for part 1
+// Same as PeelWorkList(), but using the generic cellular automaton engine: a roll (state 1) is removed
+// (state 0) when it has less than 4 neighbouring rolls in the 8-neighbourhood.
+int PeelAutomaton( const DataStream &inputData ) {
+    CellGridType grid = CreateCellGrid( inputData[0].length(), inputData.size());
+    for (int y = 0; y < grid.nHeight; y++) {
+        for (int x = 0; x < grid.nWidth; x++) {
+            grid.vCells[y * grid.nWidth + x] = (inputData[y][x] == '@') ? 1 : 0;
+        }
+    }
+    RunStatsType stats = RunAutomaton( grid, NEIGHBOURS_8, ThresholdRule{ 1, 0, 0, 3 } );
+    return stats.llChanges;
+}
+
+// solves part 2: count the paper rolls that can be removed by repeatedly removing the workable ones
+int SolvePart2( const DataStream &inputData ) {
+    return PeelWorkList( CreateBitGrid( inputData ));
+}
 
 // ==========   MAIN()
 
 int main()
 {
     glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    glbExecMode = CONCURRENT;  // execution mode SEQUENTIAL or CONCURRENT
     std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
     flcTimer tmr;
 
 /* ========== */   tmr.StartTiming();   // ============================================vvvvv
 
     // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream inputData;
-    GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
+    DataStream parsedData;
+    GetInput( parsedData, glbProgPhase != PUZZLE );
+    // both parts only read the input data, so they share it instead of each working on a copy
+    const DataStream &inputData = parsedData;
     std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
 
 /* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
 
-    // part 1 code here
-
-    // just call the function to get all unique paper roll positions that are workable...
-    std::set<vi2d> glbRollPositions = GetRollPositions( inputData );
-
-//    for (auto e : glbRollPositions) {
-//        std::cout << e.ToString() << std::endl;
-//    }
-
-    // ... and report its size
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 1: " << glbRollPositions.size() << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1: " );   // =========================^^^^^vvvvv
+    // solve both parts, sequentially or concurrently depending on glbExecMode
+    auto results = RunParts(
+        [&]() { return SolvePart1( inputData ); },
+        [&]() { return SolvePart2( inputData ); },
+        glbExecMode == CONCURRENT
+    );
 
-    inputData = part2Data; // get fresh untouched copy of input data
+    ReportPart( DAY_STRING, 1, results.first  );
+    ReportPart( DAY_STRING, 2, results.second );
 
-    // part 2 code here
-    int nCacheRemoved = 0;
-    int nTotalRemoved = 0;
+/* ========== */   tmr.TimeReport( "    Timing 1 + 2 - wall clock time both parts: " );   // =====================^^^^^vvvvv
 
-    glbRollPositions.clear();
-
-    // keep removing workable paper rolls, until no paper rolls are workable anymore
-    // accumulate the number of removed paper rolls
-    do {
-        glbRollPositions = GetRollPositions( inputData );
-        nCacheRemoved = glbRollPositions.size();
-        nTotalRemoved += nCacheRemoved;
-        for (auto pos : glbRollPositions) {
-            inputData[pos.y][pos.x] = '.';
-        }
-//        std::cout << "Removed " << nCacheRemoved << " rolls this iteration, cumulated: " << nTotalRemoved << std::endl;
-
-    } while (nCacheRemoved > 0);
-
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 2: " << nTotalRemoved << std::endl << std::endl;
+    // check the generic cellular automaton engine against the answer of part 2
+    if (PeelAutomaton( inputData ) != results.second.answer) {
+        std::cout << "ERROR: main() --> cellular automaton result differs from part 2 answer" << std::endl;
+    }
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2: " );   // ==============================^^^^^
+/* ========== */   tmr.TimeReport( "    Timing 3 - cellular automaton check: " );   // ==============================^^^^^
 
     return 0;
 }
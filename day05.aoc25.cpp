@@ -15,6 +15,10 @@
 #include "../flcTimer.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
+#include "run_parts.h"                 // used for running both parts concurrently
+#include "thread_pool.h"               // used for parallel loops
+#include "interval_set.h"              // used for merging ranges
+#include "range_query.h"               // used for checking id's against the ranges
 
 // ==========   PROGRAM STAGING
 
@@ -33,6 +37,11 @@ std::string ProgPhase2string() {
     return "unknown";
 }
 
+enum eExecMode {      // how to run the two parts - set at start of main()
+    SEQUENTIAL = 0,   //    1. solve part 1 first, then part 2
+    CONCURRENT        //    2. solve part 1 and part 2 as parallel tasks, and join them before reporting
+} glbExecMode;
+
 // ==========   INPUT DATA STRUCTURES          <<===== adapt to match columns of input file
 
 // for todays puzzle there's two types of input data:
@@ -157,47 +166,43 @@ void GetInput( RangeStream &rData, DataStream &dData, bool bDisplay = false ) {
 
 // ----- PART 1
 
-// returns true if id d falls into the range r
-bool IsInRange( DatumType &d, RangeType &r ) {
-    return r.low <= d && d <= r.hgh;
-}
-
-// returns true if there's any range in rs that contains id d
-bool IsFresh( DatumType &d, RangeStream &rs ) {
-    bool bFound = false;
-    for (int i = 0; i < (int)rs.size() && !bFound; i++) {
-        bFound = IsInRange( d, rs[i] );
+// nr of id's per parallel task
+#define ID_GRAIN  4096
+
+// The sort and merge join is used for large batches of id's against a range list that is too large for
+// the Eytzinger index to stay in cache. Measured (single thread, random id's): with 10k ranges the index
+// wins for any batch (4M id's: 157 vs 467 msec), with 635k ranges the merge join wins from 100k id's
+// (9 vs 14 msec) but not for 1000 id's (1.2 vs 0.19 msec).
+#define SORTED_MIN_RANGES  (1 << 17)
+#define SORTED_MIN_RATIO   8           // merge join if nr of id's >= nr of ranges / SORTED_MIN_RATIO
+
+// solves part 1: count the number of fresh id's in inputData
+long long SolvePart1( const RangeStream &rangeData, const DataStream &inputData ) {
+    RangeStream vMerged = MergeRanges( rangeData );
+    // for a large batch of id's against many ranges, a single merge join of the sorted id's with the ranges is cheapest
+    if (vMerged.size() >= SORTED_MIN_RANGES && inputData.size() * SORTED_MIN_RATIO >= vMerged.size()) {
+        return CountInRangesSorted( vMerged, inputData );
     }
-    return bFound;
+    // otherwise search each id in the Eytzinger index - the id's are independent, so check them in parallel chunks
+    RangeIndexType index = BuildRangeIndex( vMerged );
+    return ParallelReduce(
+        0, inputData.size(), 0LL,
+        [&]( long long lo, long long hi ) {
+            return CountInRanges( index, inputData.data(), lo, hi );
+        },
+        []( long long a, long long b ) { return a + b; },
+        ID_GRAIN
+    );
 }
 
 // ----- PART 2
 
-// returns true if ranges a and b are NOT overlapping
-bool NotOverlapping( RangeType &a, RangeType &b ) {
-    return a.hgh < b.low || b.hgh < a.low;
-}
-
-// returns true if ranges a and b ARE overlapping
-bool AreOverlapping( RangeType &a, RangeType &b ) {
-    return !NotOverlapping( a, b );
-}
-
-// Sets a to be the combination of a and b. Sets b to be invalid (with boundary values of -1)
-// ASSUMPTION: a and b are overlapping!
-void Combine( RangeType &a, RangeType &b ) {
-    RangeType res = {
-        std::min( a.low, b.low ),
-        std::max( a.hgh, b.hgh )
-    };
-    a = res;
-    b.low = b.hgh = -1;
-}
-
-// when a range is combined into another range, I flag it as invalid by
-// setting it's borders to -1
-bool IsInvalidRange( RangeType &r ) {
-    return r.low < 0 && r.hgh < 0;
+// solves part 2: count the total number of id's that the ranges in rangeData consider fresh
+long long SolvePart2( const RangeStream &rangeData ) {
+    // sort and merge the ranges into a disjoint list, in one sweep - then the merged ranges
+    // provide the unique set of fresh id's
+    RangeStream vMerged = MergeRanges( rangeData );
+    return RangeCoverage( vMerged );
 }
 
 // ==========   MAIN()
@@ -205,72 +210,34 @@ bool IsInvalidRange( RangeType &r ) {
 int main()
 {
     glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    glbExecMode = CONCURRENT;  // execution mode SEQUENTIAL or CONCURRENT
     std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
     flcTimer tmr;
 
 /* ========== */   tmr.StartTiming();   // ============================================vvvvv
 
     // get input data, depending on the glbProgPhase (example, test, puzzle)
-    RangeStream rangeData;
-    DataStream inputData;
-    GetInput( rangeData, inputData, glbProgPhase != PUZZLE );
-    RangeStream part2Range = rangeData;
-    DataStream part2Data = inputData;
+    RangeStream parsedRanges;
+    DataStream parsedData;
+    GetInput( parsedRanges, parsedData, glbProgPhase != PUZZLE );
+    // both parts only read the input data, so they share it instead of each working on a copy
+    const RangeStream &rangeData = parsedRanges;
+    const DataStream  &inputData = parsedData;
     std::cout << "Data stats - size of data stream " << rangeData.size() + inputData.size() << std::endl << std::endl;
 
 /* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
 
-    // part 1 code here
-    int nFreshCount = 0;
-    for (int i = 0; i < (int)inputData.size(); i++) {
-        if (IsFresh( inputData[i], rangeData )) {
-            nFreshCount += 1;
-        }
-    }
-
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 1: " << nFreshCount << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1: " );   // =========================^^^^^vvvvv
-
-    inputData = part2Data; // get fresh untouched copy of input data
-    rangeData = part2Range;
-
-    // part 2 code here
-
-    // first combine all ranges as much as possible - note that new overlap may become possible
-    // as a result of a Combine() action, so continue combining until all overlaps are processed
-    bool bChanged;
-    do {
-        bChanged = false;
-
-        // attempt to combine each range against each other (but skip invalid ranges)
-        for (int i = 0; i < (int)rangeData.size() - 1; i++) {
-            if (!IsInvalidRange( rangeData[i] )) {
-                for (int j = i + 1; j < (int)rangeData.size(); j++) {
-                    if (!IsInvalidRange( rangeData[j] )) {
-
-                        if (AreOverlapping( rangeData[i], rangeData[j] )) {
-                            Combine( rangeData[i], rangeData[j] );
-                            bChanged = true;
-                        }
-                    }
-                }
-            }
-        }
-    } while (bChanged);
-
-    // after no more combining is possible, the set of ranges provides the unique set of fresh id's
-    long long llTotal = 0;
-    for (int i = 0; i < (int)rangeData.size(); i++) {
-        if (!IsInvalidRange( rangeData[i] )) {
-            long long llRangeValue = rangeData[i].hgh - rangeData[i].low + 1;
-            llTotal += llRangeValue;
-        }
-    }
+    // solve both parts, sequentially or concurrently depending on glbExecMode
+    auto results = RunParts(
+        [&]() { return SolvePart1( rangeData, inputData ); },
+        [&]() { return SolvePart2( rangeData            ); },
+        glbExecMode == CONCURRENT
+    );
 
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 2: " << llTotal << std::endl << std::endl;
+    ReportPart( DAY_STRING, 1, results.first  );
+    ReportPart( DAY_STRING, 2, results.second );
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2: " );   // ==============================^^^^^
+/* ========== */   tmr.TimeReport( "    Timing 1 + 2 - wall clock time both parts: " );   // =====================^^^^^
 
     return 0;
 }
@@ -11,10 +11,14 @@
 #include <algorithm>
 #include <numeric>
 #include <vector>
+#include <cctype>
 
 #include "../flcTimer.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
+#include "run_parts.h"                 // used for running both parts concurrently
+#include "thread_pool.h"               // used for parallel loops
+#include "digit_scan.h"                // used for transposing the worksheet
 
 // ==========   PROGRAM STAGING
 
@@ -33,6 +37,11 @@ std::string ProgPhase2string() {
     return "unknown";
 }
 
+enum eExecMode {      // how to run the two parts - set at start of main()
+    SEQUENTIAL = 0,   //    1. solve part 1 first, then part 2
+    CONCURRENT        //    2. solve part 1 and part 2 as parallel tasks, and join them before reporting
+} glbExecMode;
+
 // ==========   INPUT DATA STRUCTURES          <<===== adapt to match columns of input file
 
 // the data consists of lines of tokens, the first (n-1) lines are numbers (operands), the last line contains the operators
@@ -61,6 +70,10 @@ void ReadInputData( const std::string sFileName, DataStream &vData ) {
     vData.clear();
     std::string sLine;
     while (getline( dataFileStream, sLine )) {
+        // the input files have CRLF line endings - a stray '\r' would be read as a digit or an operator
+        if (!sLine.empty() && sLine.back() == '\r') {
+            sLine.pop_back();
+        }
         vData.push_back( sLine );
     }
     dataFileStream.close();
@@ -108,167 +121,207 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 
 // ==========   PUZZLE SPECIFIC SOLUTIONS
 
-// ----- PART 1
-
-// ----- PART 2
-
-bool OnlySpaces( std::string &s ) {
-    bool bResult = true;
-    for (int i = 0; i < (int)s.length() && bResult; i++) {
-        bResult &= s[i] == ' ';
+// ----- COLUMN SEGMENTATION (shared by both parts)
+
+/*
+ * The worksheet consists of problems next to each other, each starting at the column of its operator
+ * in the last row. A single pass over the operator row gives the column span of every problem. Both
+ * parts then evaluate the problems directly from those spans on the original rows, without copying.
+ * The problems are independent, so they are evaluated in parallel.
+ */
+
+typedef struct {
+    int  nStart;        // first column of the problem
+    int  nLen;          // nr of columns, including the column of spaces that separates it from the next problem
+    char cOperator;
+} SpanType;
+typedef std::vector<SpanType> SpanStream;
+
+// returns the column spans of all problems on the worksheet dData, in one pass over the operator row
+SpanStream GetProblemSpans( const DataStream &dData ) {
+    SpanStream vSpans;
+    const std::string &sOperators = dData.back();
+    int nWidth = 0;
+    for (auto &row : dData) {
+        nWidth = std::max( nWidth, (int)row.length());
     }
-    return bResult;
+    for (int i = 0; i < (int)sOperators.length(); i++) {
+        char c = sOperators[i];
+        if (isspace( (unsigned char)c )) {
+            continue;
+        }
+        if (c != '+' && c != '*') {
+            std::cout << "ERROR: GetProblemSpans() --> unidentified operator encountered: " << c << std::endl;
+        }
+        // close the previous span, and open a new one
+        if (!vSpans.empty()) {
+            vSpans.back().nLen = i - vSpans.back().nStart;
+        }
+        vSpans.push_back( { i, 0, c } );
+    }
+    if (!vSpans.empty()) {
+        vSpans.back().nLen = nWidth - vSpans.back().nStart;
+    }
+    return vSpans;
 }
 
-// ==========   MAIN()
-
-int main()
-{
-    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
-    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
-
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
-
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream inputData;
-    GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+// returns the character at column i of row s, where rows are considered to be padded with spaces
+inline char CharAt( const std::string &s, int i ) {
+    return i < (int)s.length() ? s[i] : ' ';
+}
 
-    // part 1 code here
-    int nOperatorIx = inputData.size() - 1;
-    long long llGrandTotal = 0;
+// returns the identity value of operator cOperator: the result of an empty sum or product
+inline long long Identity( char cOperator ) {
+    return cOperator == '*' ? 1 : 0;
+}
 
-    while (inputData[0].length() > 0) {
+// combines a and b using operator cOperator
+inline long long Apply( char cOperator, long long a, long long b ) {
+    return cOperator == '*' ? a * b : a + b;
+}
 
-        // first determine token length using the operator line
-        int nTokenLength = -1;
-        for (int i = 1; i < (int)inputData[nOperatorIx].length() && nTokenLength == -1; i++) {
-            if (inputData[nOperatorIx][i] != ' ') {
-                nTokenLength = i;
+// nr of problems per parallel task
+#define PROBLEM_GRAIN  64
+
+// evaluates all problems of vSpans using fnEvaluate( dData, span ), and returns the sum of their answers
+template <class F>
+long long SumProblems( const DataStream &dData, const SpanStream &vSpans, F fnEvaluate ) {
+    return ParallelReduce(
+        0, vSpans.size(), 0LL,
+        [&]( long long lo, long long hi ) {
+            long long llTotal = 0;
+            for (long long i = lo; i < hi; i++) {
+                llTotal += fnEvaluate( dData, vSpans[i] );
             }
-        }
-        if (nTokenLength == -1) {
-            nTokenLength = inputData[nOperatorIx].length();
-        }
+            return llTotal;
+        },
+        []( long long a, long long b ) { return a + b; },
+        PROBLEM_GRAIN
+    );
+}
 
-        // then determine the operator ...
-        char cOperator = inputData[nOperatorIx][0];
+// ----- PART 1
 
-        // ... and get the operands in a std::vector, using the previously determined token length
-        std::vector<std::string> vOperands;
-        for (int i = 0; i < (int)inputData.size(); i++) {
-            std::string aux = get_token_sized( nTokenLength, inputData[i] );
-            // the operator line needs to be stripped as well, but must not be storen in vOperands
-            if (i < (int)inputData.size() - 1) {
-                vOperands.push_back( aux );
+// evaluates one problem, where the numbers are read row wise
+long long EvaluateRowWise( const DataStream &dData, const SpanType &span ) {
+    int nNrOperands = dData.size() - 1;
+    long long llAnswer = Identity( span.cOperator );
+    for (int j = 0; j < nNrOperands; j++) {
+        // accumulate the digits in the span of this row into a number - spaces are skipped
+        long long llNr = 0;
+        bool bHasDigits = false;
+        for (int i = span.nStart; i < span.nStart + span.nLen; i++) {
+            char c = CharAt( dData[j], i );
+            if (c != ' ') {
+                llNr = llNr * 10 + (c - '0');
+                bHasDigits = true;
             }
         }
-
-        // having the operator and operands worked out, combine them into a local sum answer
-        long long llLocalTotal;
-        if (cOperator == '+') {
-
-            llLocalTotal = 0;
-            for (auto e : vOperands) {
-                llLocalTotal += stoll( e );
-            }
-        } else if (cOperator == '*') {
-
-            llLocalTotal = 1;
-            for (auto e : vOperands) {
-                llLocalTotal *= stoll( e );
-            }
-        } else {
-            std::cout << "ERROR: main() [ part 1 ] --> unidentified operator encountered: " << cOperator << std::endl;
+        if (bHasDigits) {
+            llAnswer = Apply( span.cOperator, llAnswer, llNr );
         }
-
-        // accumulate the final answer
-        llGrandTotal += llLocalTotal;
     }
+    return llAnswer;
+}
 
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 1: " << llGrandTotal << std::endl << std::endl;
+// solves part 1: the numbers of each problem are read row wise
+long long SolvePart1( const DataStream &inputData, const SpanStream &vSpans ) {
+    return SumProblems( inputData, vSpans, EvaluateRowWise );
+}
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1: " );   // =========================^^^^^vvvvv
+// ----- PART 2
 
-    inputData = part2Data; // get fresh untouched copy of input data
+/*
+ * Part 2 reads the numbers column wise. To make those reads contiguous, the operand rows are first
+ * padded with spaces to a full rectangle, and then transposed (16 x 16 byte tiles at a time). Column
+ * i of the worksheet is then row i of the transposed matrix, and it's turned into a number directly.
+ */
+
+typedef struct {
+    int nNrOperands;          // nr of operand rows of the worksheet
+    int nStride;              // distance between the (transposed) columns
+    std::vector<char> vCols;  // the transposed operand rows, column i starts at i * nStride
+} ColumnMatrixType;
+
+// returns the transposed operand rows of worksheet dData (all rows except the operator row)
+ColumnMatrixType GetColumnMatrix( const DataStream &dData ) {
+    ColumnMatrixType m;
+    m.nNrOperands = dData.size() - 1;
+    int nWidth = 0;
+    for (auto &row : dData) {
+        nWidth = std::max( nWidth, (int)row.length());
+    }
+    // pad the operand rows into a rectangle of spaces, with both sides rounded up to a multiple of 16
+    // so that the transpose consists of full tiles only ...
+    int nRowsPad  = (m.nNrOperands + 15) / 16 * 16;
+    int nWidthPad = (nWidth        + 15) / 16 * 16;
+    std::vector<char> vRows( nRowsPad * nWidthPad, ' ' );
+    for (int j = 0; j < m.nNrOperands; j++) {
+        std::copy( dData[j].begin(), dData[j].end(), vRows.begin() + j * nWidthPad );
+    }
+    // ... and transpose it
+    m.nStride = nRowsPad;
+    m.vCols.assign( nWidthPad * m.nStride, ' ' );
+    TransposeBytes( vRows.data(), nRowsPad, nWidthPad, nWidthPad, m.vCols.data(), m.nStride );
+    return m;
+}
 
-    // part 2 code here
+// evaluates one problem, where the numbers are read column wise, right to left
+long long EvaluateColumnWise( const ColumnMatrixType &m, const SpanType &span ) {
+    long long llAnswer = Identity( span.cOperator );
+    for (int i = span.nStart + span.nLen - 1; i >= span.nStart; i--) {
+        // a column of only spaces has no number, so it contributes the identity value of the operator
+        bool bHasDigits;
+        long long llNr = AccumulateDigits( &m.vCols[i * m.nStride], m.nNrOperands, bHasDigits );
+        llAnswer = Apply( span.cOperator, llAnswer, bHasDigits ? llNr : Identity( span.cOperator ));
+    }
+    return llAnswer;
+}
 
-    int nNrOperands = nOperatorIx;
+// solves part 2: the numbers of each problem are read column wise, right to left
+long long SolvePart2( const DataStream &inputData, const SpanStream &vSpans ) {
+    ColumnMatrixType m = GetColumnMatrix( inputData );
+    return SumProblems( inputData, vSpans, [&m]( const DataStream &, const SpanType &span ) {
+        return EvaluateColumnWise( m, span );
+    } );
+}
 
-    llGrandTotal = 0;
-    bool bEndOfLine = false;
+// ==========   MAIN()
 
-    while (inputData[0].length() > 0) {
+int main()
+{
+    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    glbExecMode = CONCURRENT;  // execution mode SEQUENTIAL or CONCURRENT
+    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
+    flcTimer tmr;
 
-        // first determine token length using the operator line
-        int nTokenLength = -1;
-        for (int i = 1; i < (int)inputData[nOperatorIx].length() && nTokenLength == -1; i++) {
-            if (inputData[nOperatorIx][i] != ' ') {
-                nTokenLength = i;
-            }
-        }
-        if (nTokenLength == -1) {
-            nTokenLength = inputData[nOperatorIx].length();
-            bEndOfLine = true;
-        }
+/* ========== */   tmr.StartTiming();   // ============================================vvvvv
 
-        // then determine the operator ...
-        char cOperator = inputData[nOperatorIx][0];
-
-        // now we know that the operands are from 0 and have tokenlenght
-        // get the numbers, combine them into a local answer, and cumulate a global answer from it
-        long long llLocalAnswer;
-        if (cOperator == '+') {
-
-            int nNr;
-            llLocalAnswer = 0;
-            for (int i = nTokenLength - 1; i >= 0; i--) {
-                std::string nrString;
-                for (int j = 0; j < nNrOperands; j++) {
-                    nrString.push_back( inputData[j][i] );
-                }
-                nNr = OnlySpaces( nrString ) ? 0 : stoi( nrString );
-                llLocalAnswer += nNr;
-            }
-        } else if (cOperator == '*') {
-            int nNr;
-            llLocalAnswer = 1;
-            for (int i = nTokenLength - 1; i >= 0; i--) {
-                std::string nrString;
-                for (int j = 0; j < nNrOperands; j++) {
-                    nrString.push_back( inputData[j][i] );
-                }
-                nNr = OnlySpaces( nrString) ? 1 : stoi( nrString );
-                llLocalAnswer *= nNr;
-            }
-        } else {
-            std::cout << "ERROR: main() [ part 2 ] --> unidentified operator encountered: " << cOperator << std::endl;
-        }
+    // get input data, depending on the glbProgPhase (example, test, puzzle)
+    DataStream parsedData;
+    GetInput( parsedData, glbProgPhase != PUZZLE );
+    // both parts only read the input data, so they share it instead of each working on a copy
+    const DataStream &inputData = parsedData;
+    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
 
-        // trim the input lines
-        for (int i = 0; i < (int)inputData.size(); i++) {
-            if (bEndOfLine) {
-                inputData[i].clear();
-            } else {
-                std::string sRemove = get_token_sized( nTokenLength, inputData[i] );
-            }
-        }
+/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
 
-        llGrandTotal += llLocalAnswer;
+    // both parts need the column spans of the problems, so they are determined once and shared (read only) by them
+    SpanStream vSpans = GetProblemSpans( inputData );
 
+/* ========== */   tmr.TimeReport( "    Timing 0 - shared column segmentation: " );   // =======================^^^^^vvvvv
 
-//        std::cout << "Operator = " << cOperator << std::endl;
-//        std::cout << "local answer: " << llLocalAnswer << ", cumulated answer: " << llGrandTotal << std::endl;
-    }
+    // solve both parts, sequentially or concurrently depending on glbExecMode
+    auto results = RunParts(
+        [&]() { return SolvePart1( inputData, vSpans ); },
+        [&]() { return SolvePart2( inputData, vSpans ); },
+        glbExecMode == CONCURRENT
+    );
 
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 2: " << llGrandTotal << std::endl << std::endl;
+    ReportPart( DAY_STRING, 1, results.first  );
+    ReportPart( DAY_STRING, 2, results.second );
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2: " );   // ==============================^^^^^
+/* ========== */   tmr.TimeReport( "    Timing 1 + 2 - wall clock time both parts: " );   // =====================^^^^^
 
     return 0;
 }
@@ -11,10 +11,14 @@
 #include <algorithm>
 #include <numeric>
 #include <vector>
+#include <climits>
 
 #include "../flcTimer.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
+#include "run_parts.h"                 // used for running both parts concurrently
+#include "thread_pool.h"               // used for parallel loops
+#include "big_counter.h"               // used for overflow safe counting
 
 #include "vector_types.h"
 
@@ -35,6 +39,11 @@ std::string ProgPhase2string() {
     return "unknown";
 }
 
+enum eExecMode {      // how to run the two parts - set at start of main()
+    SEQUENTIAL = 0,   //    1. solve part 1 first, then part 2
+    CONCURRENT        //    2. solve part 1 and part 2 as parallel tasks, and join them before reporting
+} glbExecMode;
+
 // ==========   INPUT DATA STRUCTURES          <<===== adapt to match columns of input file
 
 // The data consists of a map containing
@@ -46,8 +55,8 @@ typedef std::string DatumType;
 typedef std::vector<DatumType> DataStream;
 
 // for convenience
-int MapWidth(  DataStream &dMap ) { return dMap[0].length(); }
-int MapHeight( DataStream &dMap ) { return dMap.size(); }
+int MapWidth(  const DataStream &dMap ) { return dMap[0].length(); }
+int MapHeight( const DataStream &dMap ) { return dMap.size(); }
 
 // ==========   INPUT DATA FUNCTIONS          <<===== adapt to match DatumType and DataStream definitions
 
@@ -131,241 +140,231 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 
 // ==========   PUZZLE SPECIFIC SOLUTIONS
 
-// ----- PART 1
+/*
+ * Beams only move down, so the map can be processed in a single sweep from top to bottom, keeping for
+ * each column the nr of time lines that has a beam in that column on the current row. A beam that hits
+ * a splitter continues in the columns left and right of it, so its time lines are added to both. This
+ * gives the answers to both parts in one sweep:
+ *   - part 1: the nr of splitters that is hit by a beam (with any nr of time lines);
+ *   - part 2: the total nr of time lines that reaches the bottom row.
+ */
 
-// get a list (std::vector) of all splitters '^' in the map
-std::vector<vi2d> GetSplitterList( DataStream &dMap ) {
-    std::vector<vi2d> vResult;
-    for (int y = 0; y < MapHeight( dMap ); y++) {
-        for (int x = 0; x < MapWidth( dMap ); x++) {
-            if (dMap[y][x] == '^') {
-                vResult.push_back( { x, y } );
-            }
-        }
-    }
-    return vResult;
-}
-
-// Performs one step in the propagation of beams in dMap. If any changes to the map are made,
-// the function returns true. False otherwise.
-bool PropagateBeamStep( DataStream &dMap ) {
-    bool bChanged = false;
+typedef struct {
+    int       nSplits;        // nr of splitters that are hit by a beam
+    long long llTimeLines;    // nr of time lines at the bottom of the map
+    bool      bOverflow;      // true if llTimeLines didn't fit in a long long
+} BeamResultType;
 
+// returns the position of the start 'S' in map dMap, or (-1, -1) if there is none
+vi2d FindStart( const DataStream &dMap ) {
     for (int y = 0; y < MapHeight( dMap ); y++) {
         for (int x = 0; x < MapWidth( dMap ); x++) {
-            // start point encountered - propagate beam one position down in the map
-            // (if it wasn't already propagated)
             if (dMap[y][x] == 'S') {
-                if (y < MapHeight( dMap ) - 1 && dMap[y + 1][x] == '.') {
-                    dMap[y + 1][x] = '|';
-                    bChanged = true;
-                }
-            } else
-            // beam segment encountered - check on the position below:
-            //   if it's an empty field, just propagate another beam segment
-            //   if it's a splitter, propagate two beams adjacent to the splitter
-            if (dMap[y][x] == '|') {
-                if (y < MapHeight( dMap ) - 1) {
-                    if (dMap[y + 1][x] == '.') {
-                        dMap[y + 1][x] = '|';
-                        bChanged = true;
-                    }
-                    if (dMap[y + 1][x] == '^') {
-                        // left to the splitter
-                        if (x > 0 && dMap[y + 1][x - 1] == '.') {
-                            dMap[y + 1][x - 1] = '|';
-                            bChanged = true;
-                        }
-                        // right to the splitter
-                        if (x < MapWidth( dMap ) - 1 && dMap[y + 1][x + 1] == '.') {
-                            dMap[y + 1][x + 1] = '|';
-                            bChanged = true;
-                        }
-                    }
-                }
+                return { x, y };
             }
-            // ignore empty spaces and splitters, they are no trigger values
-            // when it comes to propagating the beam segments
         }
     }
-    return bChanged;
+    std::cout << "ERROR: FindStart() --> no start position in map" << std::endl;
+    return { -1, -1 };
 }
 
-// the number of splits is not the same as the number of splitters, since some splitters are idling and
-// do not actually split a beam. So count only the splitters that actually get beamed onto
-int CountNrSplits( DataStream &dMap, std::vector<vi2d> &vSplitters ) {
-    int nResult = 0;
-    for (auto e : vSplitters) {
-        if (e.y > 0 && dMap[e.y - 1][e.x] == '|') {
-            nResult += 1;
+/*
+ * The nr of time lines grows exponentially with the height of the map, so the sweep is a template on the
+ * counter type (see big_counter.h). It reports an overflow instead of silently wrapping around, so that
+ * it can be redone with a wider counter type.
+ */
+
+template <class CountT>
+struct BeamCountType {
+    int    nSplits;          // nr of splitters that are hit by a beam
+    CountT timeLines;        // nr of time lines at the bottom of the map
+    bool   bOverflow;        // true if timeLines didn't fit in CountT
+};
+
+// Propagates the time line counts in vCounts from the row above to row y of map dMap. A splitter
+// passes its count to the free positions left and right of it. Returns the nr of splitters hit.
+// bOverflow is set if any of the counts doesn't fit in CountT.
+template <class CountT>
+int PropagateRow( const DataStream &dMap, int y, std::vector<CountT> &vCounts, bool &bOverflow ) {
+    int nWidth = MapWidth( dMap );
+    std::vector<CountT> vNext( nWidth, CountT( 0 ));
+    int nSplits = 0;
+    for (int x = 0; x < nWidth; x++) {
+        if (vCounts[x] == CountT( 0 )) {
+            continue;
+        }
+        if (dMap[y][x] == '^') {
+            nSplits += 1;
+            if (x > 0          && dMap[y][x - 1] != '^') { bOverflow |= AddOverflows( vNext[x - 1], vCounts[x] ); }
+            if (x < nWidth - 1 && dMap[y][x + 1] != '^') { bOverflow |= AddOverflows( vNext[x + 1], vCounts[x] ); }
+        } else {
+            bOverflow |= AddOverflows( vNext[x], vCounts[x] );
         }
     }
-    return nResult;
-}
-
-// ----- PART 2
-
-// I need some additional data structures for part 2 - a list of beam segments, the latter containing
-// the time lines value at that point in the beam graph
-typedef struct {
-    vi2d pos;
-    long long llTimeLines;
-} BeamSegmentType;
-typedef std::vector<BeamSegmentType> BeamType;
-
-// for testing and debugging
-void PrintBeamSegment( BeamSegmentType &bs ) {
-    std::cout << "bs pos: " << bs.pos.ToString() << ", timelines: " << bs.llTimeLines << std::endl;
+    vCounts.swap( vNext );
+    return nSplits;
 }
 
-// for testing and debugging
-void PrintBeam( BeamType &vBeam ) {
-    for (int i = 0; i < (int)vBeam.size(); i++) {
-        PrintBeamSegment( vBeam[i] );
+// sweeps over map dMap from the start down, and returns the nr of splits and time lines
+template <class CountT = long long>
+BeamCountType<CountT> SweepBeams( const DataStream &dMap ) {
+    BeamCountType<CountT> result = { 0, CountT( 0 ), false };
+    vi2d start = FindStart( dMap );
+    if (start.y < 0) {
+        return result;
     }
-    std::cout << std::endl;
-}
-
-// search index in vBeams std::vector where position (x, y) occurs (if anywhere)
-// returns -1 if not found
-int Index( BeamType &vBeams, int x, int y ) {
-    int nResult = -1;
-    for (int i = 0; i < (int)vBeams.size() && nResult == -1; i++) {
-        if (vBeams[i].pos.x == x && vBeams[i].pos.y == y) {
-            nResult = i;
-        }
+    std::vector<CountT> vCounts( MapWidth( dMap ), CountT( 0 ));
+    vCounts[start.x] = CountT( 1 );
+    for (int y = start.y + 1; y < MapHeight( dMap ); y++) {
+        result.nSplits += PropagateRow( dMap, y, vCounts, result.bOverflow );
+    }
+    for (auto &c : vCounts) {
+        result.bOverflow |= AddOverflows( result.timeLines, c );
     }
-    return nResult;
+    return result;
 }
 
-// returns true if a beam segment at (x, y) exists in vBeams
-bool Exists( BeamType &vBeams, int x, int y ) {
-    return (Index( vBeams, x, y ) >= 0);
+// ----- PART 1
+
+// solves part 1: count the number of times the beam is split
+int SolvePart1( const DataStream &inputData ) {
+    return SweepBeams( inputData ).nSplits;
 }
 
-// ========== case functions needed in GetBeamList() ==========
+// ----- PART 2
 
-// The beam coming from the start has just one timeline. It acts as the source of the beam graph.
-void HandleStart( DataStream &dMap, BeamType &vBeams, int x, int y ) {
-    if (!Exists( vBeams, x, y )) {
-        BeamSegmentType aux;
-        // store two segments, one at the 'S' position, and one right below it
-        aux.pos.x = x; aux.pos.y = y    ; aux.llTimeLines = 1; vBeams.push_back( aux );
-        aux.pos.x = x; aux.pos.y = y + 1; aux.llTimeLines = 1; vBeams.push_back( aux );
-    }
+// solves part 2: count the number of time lines that the beam ends up in
+// the sweep is done with 64 bit counters, and only redone with wider ones if they overflow
+std::string SolvePart2( const DataStream &inputData ) {
+    return CountWidening( [&]( auto tCount ) {
+        auto result = SweepBeams<decltype( tCount )>( inputData );
+        return std::make_pair( result.bOverflow, result.timeLines );
+    } );
 }
 
-// If the position exists as a beam segment, it is skipped, otherwise it is processed, meaning that
-//    * its time line value is derived from it's predecessors in the graph, and
-//    * a new beam segment is added to the beam segment list
-// A segment can have 1, 2 or 3 predecessors in the graph, and its time line value is the sum of the time lines of the predecessor(s)
-void HandleBar( DataStream &dMap, BeamType &vBeams, int x, int y ) {
-    if (!Exists( vBeams, x, y )) {
-        bool bSplitterLeft = x >                    0 && dMap[y    ][x - 1] == '^' && y > 0 && dMap[y - 1][x - 1] == '|';
-        bool bSplitterRght = x < MapWidth( dMap ) - 1 && dMap[y    ][x + 1] == '^' && y > 0 && dMap[y - 1][x + 1] == '|';
-        bool bBarAbove     = y >                    0 && dMap[y - 1][x    ] == '|';
-
-        int nLeftIndex = -1; long long llLeftTimeLines = 0;
-        int nRghtIndex = -1; long long llRghtTimeLines = 0;
-        int nAbveIndex = -1; long long llAbveTimeLines = 0;
-
-        if (bSplitterLeft) {
-            nLeftIndex = Index( vBeams, x - 1, y - 1 );
-            if (nLeftIndex == -1) { std::cout << "ERROR: HandleBar() --> splitter left case: could not find (" << x - 1 << ", " << y - 1 << ") index" << std::endl; }
-            llLeftTimeLines = vBeams[nLeftIndex].llTimeLines;
-        }
-        if (bSplitterRght) {
-            nRghtIndex = Index( vBeams, x + 1, y - 1 );
-            if (nRghtIndex == -1) { std::cout << "ERROR: HandleBar() --> splitter right case: could not find (" << x + 1 << ", " << y - 1 << ") index" << std::endl; }
-            llRghtTimeLines = vBeams[nRghtIndex].llTimeLines;
+// ----- ALL SOURCES
+
+/*
+ * For design studies, the answers are needed for a beam entering at every column of the top row. The
+ * sweep is the same as before, but instead of one count per column, each column carries a lane of
+ * counts, one per source column. The inner loops run over the lanes of a column, so they are
+ * vectorised by the compiler. The sources are processed in blocks of LANE_BLOCK lanes (to keep the
+ * working set small), and the blocks are independent, so they run in parallel.
+ */
+
+// nr of source columns that is swept together
+#define LANE_BLOCK  64
+
+typedef unsigned long long u64;
+
+// Propagates the lanes of counts in vCur (nLanes per column) from the row above to row y of map dMap,
+// into vNext. Adds the splitters hit per lane to vSplits. The lanes are unsigned, so an overflow wraps
+// around, and is detected per lane (a wrapped sum is smaller than what was added) into vOverflow.
+void PropagateRowLanes( const DataStream &dMap, int y, int nLanes, const std::vector<u64> &vCur,
+                        std::vector<u64> &vNext, std::vector<int> &vSplits, std::vector<char> &vOverflow ) {
+    int nWidth = MapWidth( dMap );
+    std::fill( vNext.begin(), vNext.end(), 0 );
+    // adds the lanes at pFrom to the lanes at pTo
+    auto add_lanes = [&]( const u64 *pFrom, u64 *pTo ) {
+        for (int s = 0; s < nLanes; s++) {
+            u64 nSum = pTo[s] + pFrom[s];
+            vOverflow[s] |= (nSum < pFrom[s]);
+            pTo[s] = nSum;
         }
-        if (bBarAbove) {
-            nAbveIndex = Index( vBeams, x, y - 1 );
-            if (nAbveIndex == -1) { std::cout << "ERROR: HandleBar() --> bar above case: could not find (" << x << ", " << y - 1 << ") index" << std::endl; }
-            llAbveTimeLines = vBeams[nAbveIndex].llTimeLines;
+    };
+    for (int x = 0; x < nWidth; x++) {
+        const u64 *pCur = &vCur[x * nLanes];
+        if (dMap[y][x] == '^') {
+            for (int s = 0; s < nLanes; s++) {
+                vSplits[s] += (pCur[s] != 0) ? 1 : 0;
+            }
+            if (x > 0          && dMap[y][x - 1] != '^') { add_lanes( pCur, &vNext[(x - 1) * nLanes] ); }
+            if (x < nWidth - 1 && dMap[y][x + 1] != '^') { add_lanes( pCur, &vNext[(x + 1) * nLanes] ); }
+        } else {
+            add_lanes( pCur, &vNext[x * nLanes] );
         }
-
-        long long llCumulatedTimelines = 0;
-
-        if (bSplitterLeft) { llCumulatedTimelines += llLeftTimeLines; }
-        if (bSplitterRght) { llCumulatedTimelines += llRghtTimeLines; }
-        if (bBarAbove    ) { llCumulatedTimelines += llAbveTimeLines; }
-
-        BeamSegmentType aux = { { x, y }, llCumulatedTimelines };
-        vBeams.push_back( aux );
     }
 }
 
-// converts the graph into a list of beam segments, and using HandleStart() and HandleBar() for it
-BeamType GetBeamList( DataStream &dMap ) {
-    BeamType vResult;
-
-    for (int y = 0; y < MapHeight( dMap ); y++) {
-        for (int x = 0; x < MapWidth( dMap ); x++) {
-            switch (dMap[y][x]) {
-                case 'S': HandleStart( dMap, vResult, x, y ); break;
-                case '|': HandleBar(   dMap, vResult, x, y ); break;
-                case '^': /* no action */                     break;
-                case '.': /* no action */                     break;
-                default : std::cout << "ERROR: GetBeamList() --> unknown map value: " << dMap[y][x] << std::endl;
+// Returns the nr of splits and time lines for a beam entering at each column of the top row of map
+// dMap (element x of the result is for the beam entering at column x). A start 'S' is treated as empty.
+std::vector<BeamResultType> SweepAllSources( const DataStream &dMap ) {
+    int nWidth = MapWidth( dMap );
+    std::vector<BeamResultType> vResult( nWidth, { 0, 0, false } );
+    ParallelFor(
+        0, nWidth,
+        [&]( long long lo, long long hi ) {
+            int nLanes = hi - lo;
+            std::vector<u64> vCur( nWidth * nLanes, 0 ), vNext( nWidth * nLanes, 0 );
+            std::vector<int> vSplits( nLanes, 0 );
+            std::vector<char> vOverflow( nLanes, 0 );
+            // lane s is the beam entering at column lo + s
+            for (int s = 0; s < nLanes; s++) {
+                vCur[(lo + s) * nLanes + s] = 1;
             }
-        }
-    }
+            for (int y = 1; y < MapHeight( dMap ); y++) {
+                PropagateRowLanes( dMap, y, nLanes, vCur, vNext, vSplits, vOverflow );
+                vCur.swap( vNext );
+            }
+            for (int s = 0; s < nLanes; s++) {
+                u64 nTotal = 0;
+                bool bOverflow = vOverflow[s];
+                for (int x = 0; x < nWidth; x++) {
+                    bOverflow |= AddOverflows( nTotal, vCur[x * nLanes + s] );
+                }
+                vResult[lo + s].nSplits     = vSplits[s];
+                vResult[lo + s].llTimeLines = (long long)nTotal;
+                vResult[lo + s].bOverflow   = bOverflow || nTotal > (u64)LLONG_MAX;
+            }
+        },
+        LANE_BLOCK
+    );
     return vResult;
 }
 
-// a beam segment is a leaf if it's located on the lower row of the map
-bool IsLeaf( DataStream &dMap, int x, int y ) {
-    return y == MapHeight( dMap ) - 1;
-}
-
 // ==========   MAIN()
 
 int main()
 {
     glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    glbExecMode = CONCURRENT;  // execution mode SEQUENTIAL or CONCURRENT
     std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
     flcTimer tmr;
 
 /* ========== */   tmr.StartTiming();   // ============================================vvvvv
 
     // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream inputData;
-    GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
+    DataStream parsedData;
+    GetInput( parsedData, glbProgPhase != PUZZLE );
+    // both parts only read the input data, so they share it instead of each working on a copy
+    const DataStream &inputData = parsedData;
     std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
 
 /* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
 
-    // part 1 code here
-
-    std::vector<vi2d> vSplitterList = GetSplitterList( inputData );
+    // solve both parts, sequentially or concurrently depending on glbExecMode
+    auto results = RunParts(
+        [&]() { return SolvePart1( inputData ); },
+        [&]() { return SolvePart2( inputData ); },
+        glbExecMode == CONCURRENT
+    );
 
-    do {
-        // just propagate
-    } while (PropagateBeamStep( inputData ));
+    ReportPart( DAY_STRING, 1, results.first  );
+    ReportPart( DAY_STRING, 2, results.second );
 
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 1: " << CountNrSplits( inputData, vSplitterList ) << std::endl << std::endl;
+/* ========== */   tmr.TimeReport( "    Timing 1 + 2 - wall clock time both parts: " );   // =====================^^^^^vvvvv
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1: " );   // =========================^^^^^vvvvv
-
-//    inputData = part2Data; // get fresh untouched copy of input data
-// NO: for this day in particular I need to continue with the result of part 1!
-
-    // part 2 code here
-
-    BeamType vBeamList = GetBeamList( inputData );
-
-    long long llAnswer = 0;
-    for (int i = 0; i < (int)vBeamList.size(); i++) {
-        if (IsLeaf( inputData, vBeamList[i].pos.x, vBeamList[i].pos.y )) {
-            llAnswer += vBeamList[i].llTimeLines;
-        }
+    // get the answers for a beam entering at any column of the top row, and check them against the start
+    std::vector<BeamResultType> vAllSources = SweepAllSources( inputData );
+    vi2d start = FindStart( inputData );
+    if (start.y == 0 && !vAllSources[start.x].bOverflow && (vAllSources[start.x].nSplits != results.first.answer || CountToString( vAllSources[start.x].llTimeLines ) != results.second.answer)) {
+        std::cout << "ERROR: main() --> all sources sweep differs from part 1 and 2 answers" << std::endl;
     }
+//    for (int x = 0; x < (int)vAllSources.size(); x++) {
+//        std::cout << "source: " << x << " splits: " << vAllSources[x].nSplits << " time lines: " << vAllSources[x].llTimeLines << std::endl;
+//    }
 
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 2: " << llAnswer << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2: " );   // ==============================^^^^^
+/* ========== */   tmr.TimeReport( "    Timing 3 - all sources sweep: " );   // ===================================^^^^^
 
     return 0;
 }
@@ -15,7 +15,12 @@
 #include "../flcTimer.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
+#include "run_parts.h"                 // used for running both parts concurrently
 #include "vector_types.h"
+#include "disjoint_set.h"              // used for tracking the circuits
+#include "closest_pairs.h"             // used for checking the shortest connections
+#include "kd_tree.h"                   // used for selecting the shortest connections
+#include "euclidean_mst.h"             // used for the last connection of part 2
 
 // ==========   PROGRAM STAGING
 
@@ -34,22 +39,21 @@ std::string ProgPhase2string() {
     return "unknown";
 }
 
+enum eExecMode {      // how to run the two parts - set at start of main()
+    SEQUENTIAL = 0,   //    1. solve part 1 first, then part 2
+    CONCURRENT        //    2. solve part 1 and part 2 as parallel tasks, and join them before reporting
+} glbExecMode;
+
 // ==========   INPUT DATA STRUCTURES          <<===== adapt to match columns of input file
 
-// the data consists of junction boxes which have a 3d location and may be connected to a circuit
+// the data consists of junction boxes which have a 3d location
 typedef struct {
     vi3d pos;
-    int circuitIx = -1;
 } DatumType;
 typedef std::vector<DatumType> DataStream;
 
-int GetCircuitID( DatumType &d ) {
-    return d.circuitIx;
-}
-
-bool IsConnected( DatumType &d ) {
-    return GetCircuitID( d ) != -1;
-}
+// The junction boxes may be connected into circuits. Since the input data is shared read only by both
+// parts, the circuits are kept in a disjoint set (see disjoint_set.h), indexed the same as the DataStream.
 
 // ==========   INPUT DATA FUNCTIONS          <<===== adapt to match DatumType and DataStream definitions
 
@@ -58,26 +62,26 @@ void GetData_EXAMPLE( DataStream &dData ) {
 
     // hard code your examples here - use the same data for your test input file
     DatumType cDatum;
-    cDatum = { { 162, 817, 812 }, -1 }; dData.push_back( cDatum );
-    cDatum = { {  57, 618,  57 }, -1 }; dData.push_back( cDatum );
-    cDatum = { { 906, 360, 560 }, -1 }; dData.push_back( cDatum );
-    cDatum = { { 592, 479, 940 }, -1 }; dData.push_back( cDatum );
-    cDatum = { { 352, 342, 300 }, -1 }; dData.push_back( cDatum );
-    cDatum = { { 466, 668, 158 }, -1 }; dData.push_back( cDatum );
-    cDatum = { { 542,  29, 236 }, -1 }; dData.push_back( cDatum );
-    cDatum = { { 431, 825, 988 }, -1 }; dData.push_back( cDatum );
-    cDatum = { { 739, 650, 466 }, -1 }; dData.push_back( cDatum );
-    cDatum = { {  52, 470, 668 }, -1 }; dData.push_back( cDatum );
-    cDatum = { { 216, 146, 977 }, -1 }; dData.push_back( cDatum );
-    cDatum = { { 819, 987,  18 }, -1 }; dData.push_back( cDatum );
-    cDatum = { { 117, 168, 530 }, -1 }; dData.push_back( cDatum );
-    cDatum = { { 805,  96, 715 }, -1 }; dData.push_back( cDatum );
-    cDatum = { { 346, 949, 466 }, -1 }; dData.push_back( cDatum );
-    cDatum = { { 970, 615,  88 }, -1 }; dData.push_back( cDatum );
-    cDatum = { { 941, 993, 340 }, -1 }; dData.push_back( cDatum );
-    cDatum = { { 862,  61,  35 }, -1 }; dData.push_back( cDatum );
-    cDatum = { { 984,  92, 344 }, -1 }; dData.push_back( cDatum );
-    cDatum = { { 425, 690, 689 }, -1 }; dData.push_back( cDatum );
+    cDatum = { { 162, 817, 812 } }; dData.push_back( cDatum );
+    cDatum = { {  57, 618,  57 } }; dData.push_back( cDatum );
+    cDatum = { { 906, 360, 560 } }; dData.push_back( cDatum );
+    cDatum = { { 592, 479, 940 } }; dData.push_back( cDatum );
+    cDatum = { { 352, 342, 300 } }; dData.push_back( cDatum );
+    cDatum = { { 466, 668, 158 } }; dData.push_back( cDatum );
+    cDatum = { { 542,  29, 236 } }; dData.push_back( cDatum );
+    cDatum = { { 431, 825, 988 } }; dData.push_back( cDatum );
+    cDatum = { { 739, 650, 466 } }; dData.push_back( cDatum );
+    cDatum = { {  52, 470, 668 } }; dData.push_back( cDatum );
+    cDatum = { { 216, 146, 977 } }; dData.push_back( cDatum );
+    cDatum = { { 819, 987,  18 } }; dData.push_back( cDatum );
+    cDatum = { { 117, 168, 530 } }; dData.push_back( cDatum );
+    cDatum = { { 805,  96, 715 } }; dData.push_back( cDatum );
+    cDatum = { { 346, 949, 466 } }; dData.push_back( cDatum );
+    cDatum = { { 970, 615,  88 } }; dData.push_back( cDatum );
+    cDatum = { { 941, 993, 340 } }; dData.push_back( cDatum );
+    cDatum = { { 862,  61,  35 } }; dData.push_back( cDatum );
+    cDatum = { { 984,  92, 344 } }; dData.push_back( cDatum );
+    cDatum = { { 425, 690, 689 } }; dData.push_back( cDatum );
 }
 
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
@@ -91,7 +95,7 @@ void ReadInputData( const std::string sFileName, DataStream &vData ) {
         sX = get_token_dlmtd( ",", sLine );
         sY = get_token_dlmtd( ",", sLine );
         sZ =                       sLine  ;
-        DatumType cDatum = { { stoi( sX ), stoi( sY ), stoi( sZ ) }, -1 };
+        DatumType cDatum = { { stoi( sX ), stoi( sY ), stoi( sZ ) } };
         vData.push_back( cDatum );
     }
     dataFileStream.close();
@@ -105,7 +109,7 @@ void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING;
 // output to console for testing
 void PrintDatum( DatumType &iData, bool bEndline = true ) {
     // define your datum printing code here
-    std::cout << "junction at: " << iData.pos.ToString() << " " << "part of circuit: " << iData.circuitIx;
+    std::cout << "junction at: " << iData.pos.ToString();
     if (bEndline) {
         std::cout << std::endl;
     }
@@ -141,26 +145,24 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 
 // ----- PART 1
 
-// returns straight line distance between (3D) positions of a and b
-float GetDistance( vi3d &a, vi3d &b ) {
-    return (vf3d( a ) - vf3d( b )).length();
+// returns the squared straight line distance between (3D) positions of a and b - as an integer, so that
+// distances compare exactly
+long long GetDistance2( const vi3d &a, const vi3d &b ) {
+    long long dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+    return dx * dx + dy * dy + dz * dz;
 }
 
-// typedefs to create a (sorted) distance list
-typedef struct {
-    int junctionA, junctionB;
-    float fDistance;
-} DistanceType;
-typedef std::vector<DistanceType> DistanceStream;
-
+// typedefs to create a (sorted) distance list - a pair of junction indices and their squared distance
+typedef PairEdgeType   DistanceType;
+typedef PairEdgeStream DistanceStream;
 
 void PrintDistanceType( DistanceType &d, DataStream &ds ) {
-    std::cout << "Distance: "         << d.fDistance
-              << ", junction A ID = " << d.junctionA
-              << ", junction B ID = " << d.junctionB << " --> ";
-    PrintDatum( ds[d.junctionA], false );
+    std::cout << "Squared distance: " << d.llDist2
+              << ", junction A ID = " << d.nA
+              << ", junction B ID = " << d.nB << " --> ";
+    PrintDatum( ds[d.nA], false );
     std::cout << " and ";
-    PrintDatum( ds[d.junctionB], true );
+    PrintDatum( ds[d.nB], true );
 }
 
 void PrintDistanceStream( DistanceStream &vD, DataStream &ds ) {
@@ -170,194 +172,109 @@ void PrintDistanceStream( DistanceStream &vD, DataStream &ds ) {
     std::cout << std::endl;
 }
 
-// generates and returns an exhaustive list of all possible pairs of junctions in vData, including their distance
-DistanceStream GetSortedDistancesList( DataStream &vData ) {
-    // create the list of distances between all possible pairs of junctions in vData
-    DistanceStream vResult;
-    for (int i = 0; i < (int)vData.size() - 1; i++) {
-        for (int j = i + 1; j < (int)vData.size(); j++) {
-            float fDist = GetDistance( vData[i].pos, vData[j].pos );
-            DistanceType aux = { i, j, fDist };
-            vResult.push_back( aux );
-        }
+// returns the positions of the junctions, in input order
+std::vector<vi3d> GetJunctionPoints( const DataStream &inputData ) {
+    std::vector<vi3d> vPoints;
+    for (auto &e : inputData) {
+        vPoints.push_back( e.pos );
     }
-    // sort the list in increasing distance value
-    std::sort(
-        vResult.begin(),
-        vResult.end(),
-        []( DistanceType &a, DistanceType &b ) {
-            return a.fDistance < b.fDistance;
-        }
-    );
-
-    return vResult;
+    return vPoints;
 }
 
-// typedefs to organize junctions into circuits
-typedef std::vector<int> CircuitType;
-typedef std::vector<CircuitType> CircuitStream;
-
-void PrintCircuitType( CircuitType &ct ) {
-    std::cout << "Circuit size: " << ct.size() << " --> ";
-    for (auto e : ct) {
-        std::cout << e << ", ";
+// The connectivity curve holds the circuits after adding the shortest connections one by one. The shortest
+// connections are handed out one at a time by a closest pair traversal over a k-d tree of the junctions
+// (see kd_tree.h), so the list of all pairs is never built. The curve is built until at least nMinEdges
+// connections are added, and if bUntilConnected is set, until all junctions are connected as well (later
+// connections don't change anything anymore). The connections that were used are returned in vDistances,
+// in increasing order.
+ConnectivityCurveType GetConnectivityCurve( const DataStream &inputData, DistanceStream &vDistances, int nMinEdges, bool bUntilConnected ) {
+    std::vector<vi3d> vPoints = GetJunctionPoints( inputData );
+    KdTreeType tree = BuildKdTree( vPoints );
+    ClosestPairIterType iter = CreateClosestPairIter( tree, vPoints );
+    ConnectivityCurveType curve = CreateConnectivityCurve( inputData.size());
+    vDistances.clear();
+    DistanceType e;
+    while (((int)vDistances.size() < nMinEdges || (bUntilConnected && !AllConnected( curve.ds ))) && NextClosestPair( iter, e )) {
+        AddCurveEdge( curve, e.nA, e.nB );
+        vDistances.push_back( e );
     }
-    std::cout << std::endl;
+    return curve;
 }
 
-void PrintCircuitStream( CircuitStream &cs ) {
-    for (auto e : cs) {
-        PrintCircuitType( e );
-    }
-    std::cout << std::endl;
-}
+// Checks the k-d tree queries against brute force: for each junction, its nK nearest junctions, and
+// the junctions within the distance of the farthest of those. Returns true if all queries match.
+bool CheckKdTreeQueries( const DataStream &inputData, int nK ) {
+    std::vector<vi3d> vPoints = GetJunctionPoints( inputData );
+    KdTreeType tree = BuildKdTree( vPoints );
+    bool bMatch = true;
+    for (int i = 0; i < (int)vPoints.size() && bMatch; i++) {
+        // brute force: all junctions sorted on (distance, index)
+        NeighbourStream vAll;
+        for (int j = 0; j < (int)vPoints.size(); j++) {
+            vAll.push_back( { GetDistance2( vPoints[i], vPoints[j] ), j } );
+        }
+        std::sort( vAll.begin(), vAll.end(), NeighbourLess );
 
-// For part 1 you need a table with the statistics of the circuits. More specific: you need the three largest circuits
-// and the number of junctions each of them holds. This function counts and reports these "circuit statistics".
-void PrintCircuitStatistics( CircuitStream &cs, DataStream &ds, bool bVerbose = true ) {
-    // prepare a vector with nLimit elements for counting:
-    // vCounts[i] will hold the number of circuits that contain i junctions
-    std::vector<int> vCounts;
-    int nLimit = 2000;             // this value is determined empirically
-    for (int i = 0; i < nLimit; i++) {
-        vCounts.push_back( 0 );
-    }
-    // gather the size statistics
-    for (auto e : cs) {
-        int nSize = (int)e.size();
-        if (nSize >= nLimit) {
-            std::cout << "PrintCircuitStatistics() --> too large number " << nSize << std::endl;
-        } else {
-            vCounts[nSize] += 1;
+        NeighbourStream vNearest = KNearest( tree, vPoints[i], nK );
+        int nExpected = std::min( nK, (int)vAll.size());
+        bMatch = ((int)vNearest.size() == nExpected);
+        for (int j = 0; j < nExpected && bMatch; j++) {
+            bMatch = (vNearest[j].nIndex == vAll[j].nIndex && vNearest[j].llDist2 == vAll[j].llDist2);
         }
-    }
-    // count and report the circuit statistics for 2 or more junctions
-    // collect the top three in the process
-    int nJunctionsInCircuit = 0;
-    std::vector<long long> vAnswer;
-    int nAnswerCount = 0;
-    for (int i = nLimit - 1; i >= 0; i--) {
-        if (vCounts[i] > 0) {
-            if (bVerbose) {
-                std::cout << vCounts[i] << " circuits have size " << i << std::endl;
-            }
-            nJunctionsInCircuit += (vCounts[i] * i);
-            if (nAnswerCount < 3) {
-                vAnswer.push_back( i );
-                nAnswerCount += 1;
+        if (bMatch && nExpected > 0) {
+            long long llRadius2 = vAll[nExpected - 1].llDist2;
+            NeighbourStream vInRadius = InRadius( tree, vPoints[i], llRadius2 );
+            int nInRadius = std::upper_bound(
+                vAll.begin(), vAll.end(), llRadius2,
+                []( long long r2, const NeighbourType &n ) { return r2 < n.llDist2; }
+            ) - vAll.begin();
+            bMatch = ((int)vInRadius.size() == nInRadius);
+            for (int j = 0; j < nInRadius && bMatch; j++) {
+                bMatch = (vInRadius[j].nIndex == vAll[j].nIndex);
             }
         }
     }
-    // count the number of isolated junctions (that are not part of any circuit)
-    int nIsolatedJunctions = 0;
-    for (auto e : ds) {
-        if (!IsConnected( e )) {
-            nIsolatedJunctions += 1;
-        }
-    }
-    if (bVerbose) {
-        std::cout << "junctions - in circuits = " << nJunctionsInCircuit
-                  << ", isolated = "              << nIsolatedJunctions
-                  << ", total = "                 << nJunctionsInCircuit + nIsolatedJunctions << std::endl;
-    }
-
-    // calculate and report the top 3 sizes multiplied
-    long long llTotalAnswer = 1;
-    for (int i = 0; i < nAnswerCount; i++) {
-        llTotalAnswer *= vAnswer[i];
-    }
-    std::cout << "Top 3 sizes multiplied = " << llTotalAnswer << std::endl;
+    return bMatch;
 }
 
-// This function connects two junctions identified by indices ixA and ixB into DataStream ds
-// The result of the connection is both stored in CircuitStream cs, and in the circuitIx values
-// of the ds elements.
-//
-// When connecting two junctions there are four possible scenarios:
-//   1  neither A nor B is connected --> connect A and B into a new circuit
-//   2  A is connected, B is not     --> Add B to the circuit of A
-//   3  B is connected, A is not     --> Add A to the circuit of B
-//   4  A and B are both connected AND
-//          to the same circuit      --> do nothing
-//          to different circuits    --> get the lower indexed circuit,
-//                                       combine the other into this circuit and
-//                                       dispose the higher indexed circuit
-//
-// These four scenarios are implemented below
-void Connect( CircuitStream &cs, DataStream &ds, int ixA, int ixB ) {
-
-    bool bAconnected = IsConnected( ds[ixA] );
-    bool bBconnected = IsConnected( ds[ixB] );
-
-    // case 1: neither A nor B is connected --> connect both into a new circuit
-    if (!bAconnected && !bBconnected) {
-
-        CircuitType newCircuit;          // create a new circuit and put into circuit stream
-        newCircuit.push_back( ixA );
-        newCircuit.push_back( ixB );
-        cs.push_back( newCircuit );
-
-        int nCircuitIx = cs.size() - 1;  // set the circuit indices of the junctions
-        ds[ixA].circuitIx = nCircuitIx;
-        ds[ixB].circuitIx = nCircuitIx;
-
-    } else
-    // case 2: A is connected, B is not --> add B into the circuit of A
-    if (bAconnected && !bBconnected) {
-
-        int nCircuitIx = ds[ixA].circuitIx;  // get A's circuit ID
-        cs[nCircuitIx].push_back( ixB );     // add B to that circuit
-        ds[ixB].circuitIx = nCircuitIx;      // set B's circuit ID
-
-    } else
-    // case 3: B is connected, A is not --> add A into the circuit of B
-    if (!bAconnected && bBconnected) {
-
-        int nCircuitIx = ds[ixB].circuitIx;  // get B's circuit ID
-        cs[nCircuitIx].push_back( ixA );     // add A to that circuit
-        ds[ixA].circuitIx = nCircuitIx;      // set A's circuit ID
-
-    } else
-    // case 4: both are connected ...
-    if (bAconnected && bBconnected) {
-        int nAcID = GetCircuitID( ds[ixA] );
-        int nBcID = GetCircuitID( ds[ixB] );
-        if (nAcID == nBcID) {
-            // ... to the same circuit --> do nothing
-        } else {
-            // ... to different circuits
-            if (nAcID < nBcID) {
-                // combine circuit B into circuit A and dispose of B
-                for (auto junctionB : cs[nBcID]) {
-                    cs[nAcID].push_back( junctionB );
-                    ds[junctionB].circuitIx = nAcID;
-                }
-                cs[nBcID].clear();  // Note that the circuit is not removed but only cleared!
-            } else {
-                // combine circuit A into circuit B and dispose of A
-                for (auto junctionA : cs[nAcID]) {
-                    cs[nBcID].push_back( junctionA );
-                    ds[junctionA].circuitIx = nBcID;
-                }
-                cs[nAcID].clear();  // Note that the circuit is not removed but only cleared!
-            }
-        }
-    } else {
-        std::cout << "ERROR: Connect() --> can't figure out this scenario!" << std::endl;
+// solves part 1: make the 1000 shortest connections, and multiply the sizes of the three largest circuits
+long long SolvePart1( const DataStream &inputData ) {
+    std::vector<vi3d> vPoints = GetJunctionPoints( inputData );
+    KdTreeType tree = BuildKdTree( vPoints );
+    ClosestPairIterType iter = CreateClosestPairIter( tree, vPoints );
+    DisjointSetType ds = CreateDisjointSet( inputData.size());
+    DistanceType e;
+    for (int i = 0; i < 1000 && NextClosestPair( iter, e ); i++) {
+        UnionSets( ds, e.nA, e.nB );
+    }
+    // the circuit sizes are taken from the size array of the disjoint set
+    long long llResult = 1;
+    for (int nSize : LargestComponentSizes( ds, 3 )) {
+        llResult *= nSize;
     }
+    return llResult;
 }
 
 // ----- PART 2
 
-// returns true if all junctions in ds are connected to the same circuit
-bool AllConnected( DataStream &ds ) {
-    bool bResult = IsConnected( ds[0] );
-    int nCircuitID = GetCircuitID( ds[0] );
+// The connections that join two circuits, made until all junctions are in one circuit, form the minimum
+// spanning tree of the junctions. This function returns its connections in increasing order (see euclidean_mst.h).
+DistanceStream GetSpanningTree( const DataStream &inputData ) {
+    return EuclideanMst( GetJunctionPoints( inputData ));
+}
 
-    for (int i = 1; i < (int)ds.size() && bResult; i++) {
-        bResult = (GetCircuitID( ds[i] ) == nCircuitID);
+// solves part 2: make the shortest connections until all junctions are in one circuit, and multiply the
+// X coordinates of the last two junctions that were connected - that is the last spanning tree connection
+long long SolvePart2( const DataStream &inputData ) {
+    DistanceStream vTree = GetSpanningTree( inputData );
+    if (vTree.empty()) {
+        std::cout << "ERROR: SolvePart2() --> less than 2 junctions, so there are no connections" << std::endl;
+        return 0;
     }
-    return bResult;
+    // compute the wall distance from the last two junctions' X coordinate
+    long long llXA = inputData[vTree.back().nA].pos.x;
+    long long llXB = inputData[vTree.back().nB].pos.x;
+    return llXA * llXB;
 }
 
 // ==========   MAIN()
@@ -365,69 +282,68 @@ bool AllConnected( DataStream &ds ) {
 int main()
 {
     glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    glbExecMode = CONCURRENT;  // execution mode SEQUENTIAL or CONCURRENT
     std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
     flcTimer tmr;
 
 /* ========== */   tmr.StartTiming();   // ============================================vvvvv
 
     // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream inputData;
-    GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
+    DataStream parsedData;
+    GetInput( parsedData, glbProgPhase != PUZZLE );
+    // both parts only read the input data, so they share it instead of each working on a copy
+    const DataStream &inputData = parsedData;
     std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
 
 /* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
 
-    // part 1 code here
-
-//    std::cout << "Creating distance list...";
-    DistanceStream vDistances = GetSortedDistancesList( inputData );
-//    std::cout << " done! Distances list contains " << vDistances.size() << " elements." << std::endl;
-
-    // for part 1, just create 1000 connections and check on the circuit statistics
-    CircuitStream vCircuits;
-    for (int i = 0; i < 1000; i++) {
-        Connect( vCircuits, inputData, vDistances[i].junctionA, vDistances[i].junctionB );
-    }
-//    std::cout << std::endl << "1000 connections made, getting circuit statistics: " << std::endl;
-    PrintCircuitStatistics( vCircuits, inputData, false );
-
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 1: <see above>" << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1: " );   // =========================^^^^^vvvvv
-
-    inputData = part2Data; // get fresh untouched copy of input data
-
-    // part 2 code here
-
-    for (auto &e : vCircuits) { e.clear(); }
-    vCircuits.clear();
-
-    // for part 2 - make connections until all junctions are connected in the same circuit
-    int i = 0;
-    int nCacheJunctionA, nCacheJunctionB;
-    do {
-        nCacheJunctionA = vDistances[i].junctionA;
-        nCacheJunctionB = vDistances[i].junctionB;
-
-        Connect( vCircuits, inputData, vDistances[i].junctionA, vDistances[i].junctionB );
-
-        i += 1;
-    } while (!AllConnected( inputData ));
+    // solve both parts, sequentially or concurrently depending on glbExecMode
+    auto results = RunParts(
+        [&]() { return SolvePart1( inputData ); },
+        [&]() { return SolvePart2( inputData ); },
+        glbExecMode == CONCURRENT
+    );
 
-//    std::cout << std::endl << "A total of: " << i << " connections were made, the last two junctions were: " << std::endl;
-//    PrintDatum( inputData[nCacheJunctionA] );
-//    std::cout << " and " << std::endl;
-//    PrintDatum( inputData[nCacheJunctionB] );
+    ReportPart( DAY_STRING, 1, results.first  );
+    ReportPart( DAY_STRING, 2, results.second );
 
-    // compute the wall distance from the last two junctions' X coordinate
-    long long llXA = inputData[nCacheJunctionA].pos.x;
-    long long llXB = inputData[nCacheJunctionB].pos.x;
-    long long llWallDist = llXA * llXB;
+/* ========== */   tmr.TimeReport( "    Timing 1 + 2 - wall clock time both parts: " );   // =====================^^^^^vvvvv
 
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 2: " << llWallDist << std::endl << std::endl;
+    // build the connectivity curve until all junctions are connected, and check its circuit sizes after 1000
+    // connections against the part 1 answer, that was taken from the disjoint set sizes
+    DistanceStream vAllDistances;
+    ConnectivityCurveType fullCurve = GetConnectivityCurve( inputData, vAllDistances, 1000, true );
+    if (CurveAt( fullCurve, 1000 ).llTop3 != results.first.answer) {
+        std::cout << "ERROR: main() --> full connectivity curve differs from part 1 answer" << std::endl;
+    }
+    // check the k-d tree nearest neighbour and radius queries against brute force
+    if (!CheckKdTreeQueries( inputData, 8 )) {
+        std::cout << "ERROR: main() --> k-d tree queries differ from brute force" << std::endl;
+    }
+    // check the shortest connections of the k-d tree traversal against the brute force bounded heap selection,
+    // handed out in batches of 1000 by the pair batch iterator
+    PairBatchIterType checkIter = CreatePairBatchIter( inputData.size(), 1000 );
+    DistanceStream vCheck;
+    while (vCheck.size() < vAllDistances.size()) {
+        DistanceStream vBatch = NextPairBatch( checkIter, [&]( int i, int j ) { return GetDistance2( inputData[i].pos, inputData[j].pos ); } );
+        if (vBatch.empty()) break;
+        vCheck.insert( vCheck.end(), vBatch.begin(), vBatch.end());
+    }
+    bool bSame = (vCheck.size() >= vAllDistances.size());
+    for (int i = 0; i < (int)vAllDistances.size() && bSame; i++) {
+        bSame = (vCheck[i].nA == vAllDistances[i].nA && vCheck[i].nB == vAllDistances[i].nB);
+    }
+    if (!bSame) {
+        std::cout << "ERROR: main() --> k-d tree shortest connections differ from brute force selection" << std::endl;
+    }
+    // check the last spanning tree connection against connecting the shortest connections until all are connected
+    int nLastEdge = FirstEdgeForComponents( fullCurve, 1 );
+    DistanceStream vTree = GetSpanningTree( inputData );
+    if (nLastEdge < 0 || vTree.empty() || vAllDistances[nLastEdge].nA != vTree.back().nA || vAllDistances[nLastEdge].nB != vTree.back().nB) {
+        std::cout << "ERROR: main() --> last spanning tree connection differs from full connectivity curve" << std::endl;
+    }
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2: " );   // ==============================^^^^^
+/* ========== */   tmr.TimeReport( "    Timing 3 - checks of the shortest connections and spanning tree: " );   // ^^^^^
 
     return 0;
 }
@@ -11,10 +11,13 @@
 #include <algorithm>
 #include <numeric>
 #include <vector>
+#include <climits>
 
 #include "../flcTimer.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
+#include "run_parts.h"                 // used for running both parts concurrently
+#include "thread_pool.h"               // used for parallel loops
 #include "vector_types.h"
 
 // ==========   PROGRAM STAGING
@@ -34,6 +37,11 @@ std::string ProgPhase2string() {
     return "unknown";
 }
 
+enum eExecMode {      // how to run the two parts - set at start of main()
+    SEQUENTIAL = 0,   //    1. solve part 1 first, then part 2
+    CONCURRENT        //    2. solve part 1 and part 2 as parallel tasks, and join them before reporting
+} glbExecMode;
+
 // ==========   INPUT DATA STRUCTURES          <<===== adapt to match columns of input file
 
 // the data consists of red tile locations (integer coordinates in 2d)
@@ -141,7 +149,7 @@ void PrintAreaStream( AreaStream &as, bool bOnlyFirst50 = false ) {
 }
 
 // returns the surface of the area described by corner points a and b
-long long GetAreaSurface( vi2d &a, vi2d &b ) {
+long long GetAreaSurface( const vi2d &a, const vi2d &b ) {
     long long x1 = a.x, y1 = a.y;
     long long x2 = b.x, y2 = b.y;
     return (abs( x1 - x2 ) + (long long)1) * (abs( y1 - y2 ) + (long long)1);
@@ -149,7 +157,7 @@ long long GetAreaSurface( vi2d &a, vi2d &b ) {
 
 // Creates and returns a list of all possible area's between any two (corner) points from ds
 // The returned list is sorted in decreasing surface value
-AreaStream GetAreaStream( DataStream &ds ) {
+AreaStream GetAreaStream( const DataStream &ds ) {
     // get the area for all possible combinations of corner points in a list
     AreaStream vResult;
     for (int i = 0; i < (int)ds.size() - 1; i++) {
@@ -169,6 +177,12 @@ AreaStream GetAreaStream( DataStream &ds ) {
     return vResult;
 }
 
+// solves part 1: get the largest area that can be made using any two red tiles as opposite corners
+long long SolvePart1( const DataStream &inputData ) {
+    AreaStream vAreas = GetAreaStream( inputData );
+    return vAreas[0].llSurface;
+}
+
 // ----- PART 2
 
 // =====/ Directed graph stuff / ===============
@@ -533,11 +547,26 @@ bool AreaIsValid( GraphType &g, AreaType &a, EdgeStream &es ) {
     );
 }
 
+// nr of candidate areas per parallel task
+#define AREA_GRAIN  1024
+
 // create a copy of vInput where only the "valid" areas are copied over
+// the areas are checked independently (g and es are only read), so they are checked in parallel chunks,
+// after which the valid ones are copied over in their original order
 AreaStream FilterAreaStream( GraphType &g, AreaStream &vInput, EdgeStream &es ) {
+    std::vector<char> vValid( vInput.size(), 0 );
+    ParallelFor(
+        0, vInput.size(),
+        [&]( long long lo, long long hi ) {
+            for (long long i = lo; i < hi; i++) {
+                vValid[i] = AreaIsValid( g, vInput[i], es ) ? 1 : 0;
+            }
+        },
+        AREA_GRAIN
+    );
     AreaStream vResult;
     for (int i = 0; i < (int)vInput.size(); i++) {
-        if (AreaIsValid( g, vInput[i], es )) {
+        if (vValid[i]) {
             vResult.push_back( vInput[i] );
         }
     }
@@ -559,7 +588,7 @@ int FindHorizontalEdgeIndex( EdgeStream &es, vi2d &pos ) {
     return nResult;
 }
 
-void CreateGraph( DataStream &iData, GraphType &g, EdgeStream &es ) {
+void CreateGraph( const DataStream &iData, GraphType &g, EdgeStream &es ) {
     // first get all the locations from iData into g
     // search for the ultimate upper left point in the process
     int nCacheStartPoint;
@@ -711,35 +740,8 @@ void CreateGraph( DataStream &iData, GraphType &g, EdgeStream &es ) {
     } while (nPrevNodeIx != nStartNodeIx);
 }
 
-// ==========   MAIN()
-
-int main()
-{
-    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
-    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
-
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
-
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream inputData;
-    GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
-
-    // part 1 code here
-
-    AreaStream vAreas = GetAreaStream( inputData );
-
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 1: " << vAreas[0].llSurface << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1: " );   // =========================^^^^^vvvvv
-
-    inputData = part2Data; // get fresh untouched copy of input data
-
-    // part 2 code here
+// solves part 2: like part 1, but the area must be completely inside the loop formed by the red tiles
+long long SolvePart2( const DataStream &inputData ) {
     GraphType vNodes;
     EdgeStream vEdges;
 
@@ -750,16 +752,47 @@ int main()
 //    std::cout << "graph nodes: " << std::endl;
 //    PrintGraph( vNodes, vEdges );
 
-    vAreas = GetAreaStream( inputData );
+    AreaStream vAreas = GetAreaStream( inputData );
 
 //    std::cout << "filtering area list: " << std::endl;
     AreaStream vFilteredAreas = FilterAreaStream( vNodes, vAreas, vEdges );
 //    std::cout << "result list: " << std::endl;
 //    PrintAreaStream( vFilteredAreas, true );
 
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 2: " << vFilteredAreas[0].llSurface << std::endl << std::endl;
+    return vFilteredAreas[0].llSurface;
+}
+
+// ==========   MAIN()
+
+int main()
+{
+    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    glbExecMode = CONCURRENT;  // execution mode SEQUENTIAL or CONCURRENT
+    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
+    flcTimer tmr;
+
+/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+
+    // get input data, depending on the glbProgPhase (example, test, puzzle)
+    DataStream parsedData;
+    GetInput( parsedData, glbProgPhase != PUZZLE );
+    // both parts only read the input data, so they share it instead of each working on a copy
+    const DataStream &inputData = parsedData;
+    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
+
+/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+
+    // solve both parts, sequentially or concurrently depending on glbExecMode
+    auto results = RunParts(
+        [&]() { return SolvePart1( inputData ); },
+        [&]() { return SolvePart2( inputData ); },
+        glbExecMode == CONCURRENT
+    );
+
+    ReportPart( DAY_STRING, 1, results.first  );
+    ReportPart( DAY_STRING, 2, results.second );
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2: " );   // ==============================^^^^^
+/* ========== */   tmr.TimeReport( "    Timing 1 + 2 - wall clock time both parts: " );   // =====================^^^^^
 
     return 0;
 }
@@ -126,13 +126,13 @@ void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING;
 // ==========   CONSOLE OUTPUT FUNCTIONS          <<===== adapt to match DatumType and DataStream definitions
 
 // output to console for testing
-void PrintDatum( DatumType &iData, bool bEndline = true ) {
+void PrintDatum( const DatumType &iData, bool bEndline = true ) {
     // output indicator lights scheme
     std::cout << "[ " << iData.sIndLights << " ] - ";
     // output wire schemes
     for (int i = 0; i < (int)iData.vvWireSchemes.size(); i++) {
         std::cout << "(";
-        NumberRange &curScheme = iData.vvWireSchemes[i];
+        const NumberRange &curScheme = iData.vvWireSchemes[i];
         for (int j = 0; j < (int)curScheme.size(); j++) {
             std::cout << curScheme[j];
             if (j < (int)curScheme.size() - 1) {
@@ -200,9 +200,9 @@ void ToggleIndicator( std::string &sLights, int nLightIndex ) {
 // Take the wiring scheme from iDatum with index nButtonIndex, and toggle all the indicator lights
 // according to the wiring scheme
 // the result string is returned
-std::string ApplyButton( DatumType &iDatum, int nButtonIndex, std::string &sInput ) {
+std::string ApplyButton( const DatumType &iDatum, int nButtonIndex, std::string &sInput ) {
     CheckIndex( "ApplyButton() 1", nButtonIndex, 0, (int)iDatum.vvWireSchemes.size() );
-    NumberRange &vWireScheme = iDatum.vvWireSchemes[nButtonIndex];
+    const NumberRange &vWireScheme = iDatum.vvWireSchemes[nButtonIndex];
     std::string sResult = sInput;
     for (int i = 0; i < (int)vWireScheme.size(); i++) {
         ToggleIndicator( sResult, vWireScheme[i] );
@@ -336,13 +336,13 @@ bool IsRelevant( MemoStream &ms, std::string &slghts, int nLvl ) {
 // perform breadth first search (using a queue, modelled by a std::deque) to explore
 // the paths for pushing buttons in iData[nDatumIx].
 // Since the input datum index is fed into the tree nodes, we need it as a separate parameter
-int BFS( DataStream &iData, int nDatumIx, int nLimit = 1 ) {
+int BFS( const DataStream &iData, int nDatumIx, int nLimit = 1 ) {
 
     CheckIndex( "BFS()", nDatumIx, 0, iData.size());
 
     int nResultSteps = 0;
 
-    DatumType &iDatum = iData[nDatumIx];
+    const DatumType &iDatum = iData[nDatumIx];
     std::deque<TreeNodePtr> Q;
     MemoStream vMemos;
 
@@ -435,12 +435,12 @@ void PrintSolutionSet( SolutionSetType &vvSet ) {
 
 // every button from the input datum can be pushed 0 or 1 time, so create a table with all possibilities
 // and check whether that button push configuration is a solution
-SolutionSetType GetSolutionSet( DataStream &inputData, int nDatumIx, std::string &sLights ) {
+SolutionSetType GetSolutionSet( const DataStream &inputData, int nDatumIx, std::string &sLights ) {
     // prepare some var's for easy reference
 
     CheckIndex( "GetSolutionSet()", nDatumIx, 0, inputData.size());
 
-    DatumType &curDatum = inputData[nDatumIx];
+    const DatumType &curDatum = inputData[nDatumIx];
 //    int nNrButtons = (int)curDatum.vvWireSchemes.size();
     int nNrButtons = (int)curDatum.vvWireSchemes.size();
     int nNrPossibilities = PowerTwo( nNrButtons );
@@ -506,7 +506,7 @@ bool ContainsNegatives( NumberRange &vJoltLevels ) {
     return bNegFound;
 }
 
-NumberRange ApplyButton( DatumType &curDatum, int nButtonIx, NumberRange &vJoltLevels ) {
+NumberRange ApplyButton( const DatumType &curDatum, int nButtonIx, NumberRange &vJoltLevels ) {
     NumberRange vResult = vJoltLevels;
 
     CheckIndex( "ApplyButton() 2", nButtonIx, 0, (int)curDatum.vvWireSchemes.size());
@@ -523,7 +523,7 @@ NumberRange ApplyButton( DatumType &curDatum, int nButtonIx, NumberRange &vJoltL
 
 #define INVALID 100000000
 
-int MinimumButtons( DataStream &inputData, int nDatumIx, NumberRange &vJoltageLevels ) {
+int MinimumButtons( const DataStream &inputData, int nDatumIx, NumberRange &vJoltageLevels ) {
 
     CheckIndex( "MinimumButtons()", nDatumIx, 0, (int)inputData.size());
 
@@ -534,7 +534,7 @@ std::cout << "and joltage levels: "; PrintNumberRange( vJoltageLevels );
 
 
     NumberRange vRemainingJoltage = vJoltageLevels;
-    DatumType &curDatum = inputData[nDatumIx];
+    const DatumType &curDatum = inputData[nDatumIx];
 
     // suppose all values in vRemainingJoltage are zero --> answer is 0
     // else suppose some values are below zero --> answer is INVALID
@@ -661,9 +661,10 @@ int main()
 /* ========== */   tmr.StartTiming();   // ============================================vvvvv
 
     // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream inputData;
-    GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
+    DataStream parsedData;
+    GetInput( parsedData, glbProgPhase != PUZZLE );
+    // both parts only read the input data, so they share it instead of each working on a copy
+    const DataStream &inputData = parsedData;
     std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
 
 /* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
@@ -682,14 +683,14 @@ int main()
 
 /* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1: " );   // =========================^^^^^vvvvv
 
-    inputData = part2Data; // get fresh untouched copy of input data
-
     // part 2 code here
+    // the machines are independent, but this loop is kept sequential: MinimumButtons() traces every call to
+    // std::cout, which would interleave if the machines were spread over threads
     int nTotal = 0;
 
     for (int i = 0; i < (int)inputData.size(); i++) {
 
-        DatumType &curDatum = inputData[i];
+        const DatumType &curDatum = inputData[i];
         std::cout << "Processing datum: " << i << " " << std::endl;
         PrintDatum( curDatum );
 
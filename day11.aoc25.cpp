@@ -15,6 +15,7 @@
 #include "../flcTimer.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
+#include "big_counter.h"               // used for overflow safe counting
 
 // ==========   PROGRAM STAGING
 
@@ -134,7 +135,7 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 //  the right getter functions on the input data.
 
 // Returns the index of the graph node identified by label. If not found, returns -1
-int GetNodeIndex( DataStream &graphData, const DevName &label ) {
+int GetNodeIndex( const DataStream &graphData, const DevName &label ) {
     int nResult = -1;
     for (int i = 0; i < (int)graphData.size() && nResult < 0; i++) {
         if (graphData[i].sDevID == label) {
@@ -145,19 +146,19 @@ int GetNodeIndex( DataStream &graphData, const DevName &label ) {
 }
 
 // Returns the node ID (label) of the graph node indexed by nIndex.
-DevName &GetNodeID( DataStream &graphData, int nIndex ) {
+const DevName &GetNodeID( const DataStream &graphData, int nIndex ) {
     CheckIndex( "GetNodeID()", nIndex, 0, (int)graphData.size());
     return graphData[nIndex].sDevID;
 }
 
 // Returns a reference to the std::vector of outputs of the graph node indexed by nIndex.
-std::vector<DevName> &GetNodeOutputs( DataStream &graphData, int nIndex ) {
+const std::vector<DevName> &GetNodeOutputs( const DataStream &graphData, int nIndex ) {
     CheckIndex( "GetNodeOutputs()", nIndex, 0, (int)graphData.size());
     return graphData[nIndex].vOutputs;
 }
 
 // recursive depht first search algorithm
-long long DFS1( DataStream &graphData, const DevName &sCurNodeID, const DevName &sEndNodeID ) {
+long long DFS1( const DataStream &graphData, const DevName &sCurNodeID, const DevName &sEndNodeID ) {
 
     long long llResult = -1;
     if (sCurNodeID == sEndNodeID) {
@@ -171,7 +172,7 @@ long long DFS1( DataStream &graphData, const DevName &sCurNodeID, const DevName
         if (nCurNodeIndex == -1) {
             std::cout << "ERROR: DFS1() --> could not find graph node with ID: " << sCurNodeID << std::endl;
         }
-        std::vector<DevName> &vSuccessors = GetNodeOutputs( graphData, nCurNodeIndex );
+        const std::vector<DevName> &vSuccessors = GetNodeOutputs( graphData, nCurNodeIndex );
         // recursively run the dfs algo on each successor node, and combine the results
         for (int i = 0; i < (int)vSuccessors.size(); i++) {
             DevName sNghbID = vSuccessors[i];
@@ -185,18 +186,24 @@ long long DFS1( DataStream &graphData, const DevName &sCurNodeID, const DevName
 
 // Some form of memoization is needed to speed up the dfs process for part 2.
 
+// The number of paths grows exponentially with the size of the graph, so the counting is generic over
+// the counter type CountT (see big_counter.h), and reports an overflow instead of wrapping around.
+
 // A memo contains the node id, both flags indicating whether "dac" or "fft" were visited and the resulting number of paths value
-typedef struct sMemoElt {
+template <class CountT>
+struct MemoElt {
     DevName   sID;
     bool      bVisitedDAC,
               bVisitedFFT;
-    long long llResult;
-} MemoElt;
-typedef std::vector<MemoElt> MemoType;
+    CountT    result;
+};
+template <class CountT>
+using MemoType = std::vector<MemoElt<CountT>>;
 
 // Look for the memo that contains the combination (sID, bDAC, bFFT) and return its index if found.
 // Return -1 if not found.
-int GetMemoIndex( MemoType &memo, const DevName &sID, bool bDAC, bool bFFT ) {
+template <class CountT>
+int GetMemoIndex( MemoType<CountT> &memo, const DevName &sID, bool bDAC, bool bFFT ) {
     int nResult = -1;
 
     // I wanna be sure on this bool comparison, so make it explicit
@@ -217,54 +224,59 @@ int GetMemoIndex( MemoType &memo, const DevName &sID, bool bDAC, bool bFFT ) {
 }
 
 // returns true if the combination (sID, bDAC, bFFT) is in the memoization, false otherwise
-bool IsInMemo( MemoType &memo, const DevName &sID, bool bDAC, bool bFFT ) {
+template <class CountT>
+bool IsInMemo( MemoType<CountT> &memo, const DevName &sID, bool bDAC, bool bFFT ) {
     return GetMemoIndex( memo, sID, bDAC, bFFT ) >= 0;
 }
 
 // return memo result value using nIndex
-long long GetMemoResult( MemoType &memo, int nIndex ) {
+template <class CountT>
+CountT GetMemoResult( MemoType<CountT> &memo, int nIndex ) {
     CheckIndex( "GetMemoResult() [1]", nIndex, 0, memo.size());
-    return memo[nIndex].llResult;
+    return memo[nIndex].result;
 }
 
 // return memo result value using (sID, bDAC, bFFT) combination
-long long GetMemoResult( MemoType &memo, const DevName &sID, bool bDAC, bool bFFT ) {
+template <class CountT>
+CountT GetMemoResult( MemoType<CountT> &memo, const DevName &sID, bool bDAC, bool bFFT ) {
     int nIndex = GetMemoIndex( memo, sID, bDAC, bFFT );
     CheckIndex( "GetMemoResult() [2]", nIndex, 0, memo.size());
-    return memo[nIndex].llResult;
+    return memo[nIndex].result;
 }
 
 // store a new memo with the function parameters as its value
-void PutMemoResult( MemoType &memo, const DevName &sID, bool bDAC, bool bFFT, long long llResult ) {
-    MemoElt me = { sID, bDAC, bFFT, llResult };
+template <class CountT>
+void PutMemoResult( MemoType<CountT> &memo, const DevName &sID, bool bDAC, bool bFFT, const CountT &result ) {
+    MemoElt<CountT> me = { sID, bDAC, bFFT, result };
     memo.push_back( me );
 }
 
 // a slightly more enhanced version of the depth first search algo from part 1:
 //   * parameters are passed in the recursive call that indicate whether "dac" or "fft" have been visited
 //   * memoization is applied to speed up the process
-long long DFS2( DataStream &graphData, const DevName &sCurNodeID, const DevName &sEndNodeID, bool bVstdDAC, bool bVstdFFT, MemoType &memo ) {
+//   * the path counts are added with overflow detection - bOverflow is set if the count doesn't fit in CountT
+template <class CountT>
+CountT DFS2( const DataStream &graphData, const DevName &sCurNodeID, const DevName &sEndNodeID, bool bVstdDAC, bool bVstdFFT, MemoType<CountT> &memo, bool &bOverflow ) {
 
-    long long llResult = -1;
+    CountT result = CountT( 0 );
     if (sCurNodeID == sEndNodeID) {
         // The algorithm got upto the final node.
         if (bVstdDAC && bVstdFFT) {
             // If dac and fft were encountered in the process, then this path is valid, and accounts for 1
-            llResult = 1;
+            result = CountT( 1 );
         } else {
             // otherwise the path is not valid and accounts for 0
-            llResult = 0;
+            result = CountT( 0 );
         }
     } else {
         // first check if memoization can be used
         int nMemoIndex = GetMemoIndex( memo, sCurNodeID, bVstdDAC, bVstdFFT );
         if (nMemoIndex >= 0) {
             // return the previously stored result for this combination (sCurNodeID, bVstdDAC, bVstdFFT) if it exists
-            llResult = GetMemoResult( memo, nMemoIndex );
+            result = GetMemoResult( memo, nMemoIndex );
         } else {
 
             // prepare for recursive calls on the successors of current node
-            llResult = 0;
             bVstdDAC |= (sCurNodeID == "dac");
             bVstdFFT |= (sCurNodeID == "fft");
 
@@ -272,21 +284,18 @@ long long DFS2( DataStream &graphData, const DevName &sCurNodeID, const DevName
             if (nCurNodeIndex == -1) {
                 std::cout << "ERROR: DFS2() --> could not find graph node with ID: " << sCurNodeID << std::endl;
             }
-            std::vector<DevName> &vSuccessors = GetNodeOutputs( graphData, nCurNodeIndex );
+            const std::vector<DevName> &vSuccessors = GetNodeOutputs( graphData, nCurNodeIndex );
             // recursively call the dfs algo on the successors, combining the result
             for (int i = 0; i < (int)vSuccessors.size(); i++) {
-                llResult += DFS2( graphData, vSuccessors[i], sEndNodeID, bVstdDAC, bVstdFFT, memo );
+                bOverflow |= AddOverflows( result, DFS2( graphData, vSuccessors[i], sEndNodeID, bVstdDAC, bVstdFFT, memo, bOverflow ));
             }
         }
     }
-    if (llResult < 0) {
-        std::cout << "ERROR: DFS2() --> (intermediate) result is negative: " << llResult << std::endl;
-    }
 
     // store the result for this combination (sCurNodeID, bVstdDAC, bVstdFFT) for future use
-    PutMemoResult( memo, sCurNodeID, bVstdDAC, bVstdFFT, llResult );
+    PutMemoResult( memo, sCurNodeID, bVstdDAC, bVstdFFT, result );
 
-    return llResult;
+    return result;
 }
 
 // ==========   MAIN()
@@ -300,9 +309,10 @@ int main()
 /* ========== */   tmr.StartTiming();   // ============================================vvvvv
 
     // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream inputData;
-    GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
+    DataStream parsedData;
+    GetInput( parsedData, glbProgPhase != PUZZLE );
+    // both parts only read the input data, so they share it instead of each working on a copy
+    const DataStream &inputData = parsedData;
     std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
 
 /* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
@@ -315,14 +325,20 @@ int main()
 
 /* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1: " );   // =========================^^^^^vvvvv
 
-    inputData = part2Data; // get fresh untouched copy of input data
-
     // part 2 code here
 
-    MemoType c;
-    long long llResult2 = DFS2( inputData, "svr", "out", false, false, c );
+    // count with long long first, and only if that overflows, count again with a wider counter type
+    std::string sResult2 = CountWidening(
+        [&]( auto tCount ) {
+            typedef decltype( tCount ) CountT;
+            MemoType<CountT> memo;
+            bool bOverflow = false;
+            CountT result = DFS2<CountT>( inputData, "svr", "out", false, false, memo, bOverflow );
+            return std::make_pair( bOverflow, result );
+        }
+    );
 
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 2: " << llResult2 << std::endl << std::endl;
+    std::cout << std::endl << "Answer to " << DAY_STRING << " part 2: " << sResult2 << std::endl << std::endl;
 
 /* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2: " );   // ==============================^^^^^
 
@@ -15,6 +15,7 @@
 #include "../flcTimer.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
+#include "thread_pool.h"               // used for parallel loops
 
 // ==========   PROGRAM STAGING
 
@@ -209,7 +210,7 @@ typedef std::vector<CasusType> CasusStream;
 
 // Check on surface needed vs available for the region r (which has index nRegIx in the input data)
 // Return the result as a CasusType variable
-CasusType GetCasusInfo( RegionType &r, int nRegIx, ShapeStream &ss ) {
+CasusType GetCasusInfo( const RegionType &r, int nRegIx, const ShapeStream &ss ) {
 
     CasusType result;
     result.nRegionIndex = nRegIx;
@@ -239,11 +240,12 @@ int main()
 /* ========== */   tmr.StartTiming();   // ============================================vvvvv
 
     // get input data, depending on the glbProgPhase (example, test, puzzle)
-    ShapeStream inputShapes;
-    RegionStream inputRegions;
-    GetInput( inputShapes, inputRegions, glbProgPhase != PUZZLE );
-    ShapeStream part2Shapes = inputShapes;
-    RegionStream part2Regions = inputRegions;
+    ShapeStream parsedShapes;
+    RegionStream parsedRegions;
+    GetInput( parsedShapes, parsedRegions, glbProgPhase != PUZZLE );
+    // both parts only read the input data, so they share it instead of each working on a copy
+    const ShapeStream  &inputShapes  = parsedShapes;
+    const RegionStream &inputRegions = parsedRegions;
 
     std::cout << "Data stats - size of shape stream " << inputShapes.size()
               <<                " and region stream " << inputRegions.size() << std::endl << std::endl;
@@ -253,13 +255,18 @@ int main()
     // part 1 code here
 
 
-    CasusStream vCasus;
+    CasusStream vCasus( inputRegions.size());
     // for each region, get the difference between the surface needed and available
-    for (int i = 0; i < (int)inputRegions.size(); i++) {
-//        std::cout << std::endl << "Processing region: " << i << std::endl;
-        CasusType curCase = GetCasusInfo( inputRegions[i], i, inputShapes );
-        vCasus.push_back( curCase );
-    }
+    // the regions are independent, so they are processed in parallel chunks
+    ParallelFor(
+        0, inputRegions.size(),
+        [&]( long long lo, long long hi ) {
+            for (long long i = lo; i < hi; i++) {
+//                std::cout << std::endl << "Processing region: " << i << std::endl;
+                vCasus[i] = GetCasusInfo( inputRegions[i], i, inputShapes );
+            }
+        }
+    );
 
 //    // sort the list for easy (manual) analysis
 //    std::sort(
@@ -309,9 +316,6 @@ int main()
 
 /* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1: " );   // =========================^^^^^vvvvv
 
-    inputShapes = part2Shapes; // get fresh untouched copy of input data
-    inputRegions = part2Regions;
-
     // part 2 code here
 
 
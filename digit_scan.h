@@ -0,0 +1,184 @@
+// AoC 2025 - digit scanning kernels
+// =================================
+
+// date:  2026-10-19
+
+#ifndef DIGIT_SCAN_H
+#define DIGIT_SCAN_H
+
+#if defined( __AVX2__ ) || defined( __SSE2__ )
+#include <immintrin.h>
+#endif
+
+//                          +--------------------+                           //
+// -------------------------+ MODULE DESCRIPTION +-------------------------- //
+//                          +--------------------+                           //
+
+/*
+ * Kernels for scanning rows of (ASCII) digits, or any other bytes.
+ *
+ * FirstArgMax() returns the index of the first occurrence of the largest byte in [ lo, hi ). It works
+ * in two steps: first the maximum is determined by comparing 32 (AVX2) or 16 (SSE2) bytes per step,
+ * then the first position holding that maximum is found by comparing against it and taking the lowest
+ * set bit of the lane mask. Without AVX2 or SSE2 support it falls back to a plain loop.
+ *
+ * The bytes are compared as unsigned values.
+ *
+ * TransposeBytes() transposes a matrix of bytes, so that columns can be read as contiguous rows. Full
+ * 16 x 16 tiles are transposed in SSE2 registers with four rounds of unpack instructions (8, 16, 32 and
+ * 64 bit interleaving). The edges that don't fill a whole tile are transposed byte by byte.
+ *
+ * AccumulateDigits() turns a row of digits into a number, skipping spaces.
+ */
+
+// returns the index of the first maximum byte in p[lo] .. p[hi - 1], or lo if the range is empty
+inline int FirstArgMaxScalar( const char *p, int lo, int hi ) {
+    int nFound = lo;
+    unsigned char cMax = 0;
+    for (int i = lo; i < hi; i++) {
+        if ((unsigned char)p[i] > cMax) {
+            cMax = (unsigned char)p[i];
+            nFound = i;
+        }
+    }
+    return nFound;
+}
+
+// returns the largest byte in p[lo] .. p[hi - 1] (0 if the range is empty)
+inline unsigned char MaxByte( const char *p, int lo, int hi ) {
+    int i = lo;
+    unsigned char cMax = 0;
+#if defined( __AVX2__ )
+    __m256i vMax = _mm256_setzero_si256();
+    for (; i + 32 <= hi; i += 32) {
+        vMax = _mm256_max_epu8( vMax, _mm256_loadu_si256( (const __m256i *)(p + i)));
+    }
+    // fold the 32 lanes into 16 and continue with SSE2
+    __m128i vMax16 = _mm_max_epu8( _mm256_castsi256_si128( vMax ), _mm256_extracti128_si256( vMax, 1 ));
+#elif defined( __SSE2__ )
+    __m128i vMax16 = _mm_setzero_si128();
+#endif
+#if defined( __AVX2__ ) || defined( __SSE2__ )
+    for (; i + 16 <= hi; i += 16) {
+        vMax16 = _mm_max_epu8( vMax16, _mm_loadu_si128( (const __m128i *)(p + i)));
+    }
+    vMax16 = _mm_max_epu8( vMax16, _mm_srli_si128( vMax16, 8 ));
+    vMax16 = _mm_max_epu8( vMax16, _mm_srli_si128( vMax16, 4 ));
+    vMax16 = _mm_max_epu8( vMax16, _mm_srli_si128( vMax16, 2 ));
+    vMax16 = _mm_max_epu8( vMax16, _mm_srli_si128( vMax16, 1 ));
+    cMax = (unsigned char)_mm_cvtsi128_si32( vMax16 );
+#endif
+    for (; i < hi; i++) {
+        if ((unsigned char)p[i] > cMax) {
+            cMax = (unsigned char)p[i];
+        }
+    }
+    return cMax;
+}
+
+// returns the index of the first byte in p[lo] .. p[hi - 1] that equals c, or hi if there is none
+inline int FindByte( const char *p, int lo, int hi, unsigned char c ) {
+    int i = lo;
+#if defined( __AVX2__ )
+    __m256i vC32 = _mm256_set1_epi8( (char)c );
+    for (; i + 32 <= hi; i += 32) {
+        unsigned nMask = (unsigned)_mm256_movemask_epi8( _mm256_cmpeq_epi8( vC32, _mm256_loadu_si256( (const __m256i *)(p + i))));
+        if (nMask != 0) {
+            return i + __builtin_ctz( nMask );
+        }
+    }
+#endif
+#if defined( __AVX2__ ) || defined( __SSE2__ )
+    __m128i vC16 = _mm_set1_epi8( (char)c );
+    for (; i + 16 <= hi; i += 16) {
+        unsigned nMask = (unsigned)_mm_movemask_epi8( _mm_cmpeq_epi8( vC16, _mm_loadu_si128( (const __m128i *)(p + i))));
+        if (nMask != 0) {
+            return i + __builtin_ctz( nMask );
+        }
+    }
+#endif
+    for (; i < hi; i++) {
+        if ((unsigned char)p[i] == c) {
+            return i;
+        }
+    }
+    return hi;
+}
+
+// returns the index of the first maximum byte in p[lo] .. p[hi - 1], or lo if the range is empty
+inline int FirstArgMax( const char *p, int lo, int hi ) {
+    if (hi - lo < 16) {
+        return FirstArgMaxScalar( p, lo, hi );
+    }
+    return FindByte( p, lo, hi, MaxByte( p, lo, hi ));
+}
+
+// transposes the 16 x 16 tile at pSrc (rows nSrcStride bytes apart) to pDst (rows nDstStride bytes apart)
+inline void Transpose16x16( const char *pSrc, int nSrcStride, char *pDst, int nDstStride ) {
+#if defined( __SSE2__ )
+    __m128i r[16], t[16];
+    for (int i = 0; i < 16; i++) {
+        r[i] = _mm_loadu_si128( (const __m128i *)(pSrc + i * nSrcStride));
+    }
+    for (int k = 0; k < 8; k++) {
+        t[k    ] = _mm_unpacklo_epi8( r[2 * k], r[2 * k + 1] );
+        t[k + 8] = _mm_unpackhi_epi8( r[2 * k], r[2 * k + 1] );
+    }
+    for (int g = 0; g < 16; g += 8) {
+        for (int k = 0; k < 4; k++) {
+            r[g + k    ] = _mm_unpacklo_epi16( t[g + 2 * k], t[g + 2 * k + 1] );
+            r[g + k + 4] = _mm_unpackhi_epi16( t[g + 2 * k], t[g + 2 * k + 1] );
+        }
+    }
+    for (int g = 0; g < 16; g += 4) {
+        for (int k = 0; k < 2; k++) {
+            t[g + k    ] = _mm_unpacklo_epi32( r[g + 2 * k], r[g + 2 * k + 1] );
+            t[g + k + 2] = _mm_unpackhi_epi32( r[g + 2 * k], r[g + 2 * k + 1] );
+        }
+    }
+    for (int g = 0; g < 16; g += 2) {
+        _mm_storeu_si128( (__m128i *)(pDst +  g      * nDstStride), _mm_unpacklo_epi64( t[g], t[g + 1] ));
+        _mm_storeu_si128( (__m128i *)(pDst + (g + 1) * nDstStride), _mm_unpackhi_epi64( t[g], t[g + 1] ));
+    }
+#else
+    for (int i = 0; i < 16; i++) {
+        for (int j = 0; j < 16; j++) {
+            pDst[j * nDstStride + i] = pSrc[i * nSrcStride + j];
+        }
+    }
+#endif
+}
+
+// Transposes the nRows x nCols matrix at pSrc (rows nSrcStride bytes apart) to the nCols x nRows
+// matrix at pDst (rows nDstStride bytes apart)
+inline void TransposeBytes( const char *pSrc, int nRows, int nCols, int nSrcStride, char *pDst, int nDstStride ) {
+    int nFullRows = nRows - nRows % 16;
+    int nFullCols = nCols - nCols % 16;
+    for (int i = 0; i < nFullRows; i += 16) {
+        for (int j = 0; j < nFullCols; j += 16) {
+            Transpose16x16( pSrc + i * nSrcStride + j, nSrcStride, pDst + j * nDstStride + i, nDstStride );
+        }
+    }
+    // the right and bottom edges that don't fill a whole tile
+    for (int i = 0; i < nRows; i++) {
+        for (int j = (i < nFullRows ? nFullCols : 0); j < nCols; j++) {
+            pDst[j * nDstStride + i] = pSrc[i * nSrcStride + j];
+        }
+    }
+}
+
+// Returns the number formed by the digits in p[0] .. p[n - 1], skipping spaces. bHasDigits is set
+// to false if there are only spaces.
+inline long long AccumulateDigits( const char *p, int n, bool &bHasDigits ) {
+    long long llNr = 0;
+    int nDigits = 0;
+    for (int i = 0; i < n; i++) {
+        bool bDigit = (p[i] != ' ');
+        llNr = bDigit ? llNr * 10 + (p[i] - '0') : llNr;
+        nDigits += bDigit ? 1 : 0;
+    }
+    bHasDigits = (nDigits > 0);
+    return llNr;
+}
+
+#endif // DIGIT_SCAN_H
@@ -0,0 +1,189 @@
+// AoC 2025 - disjoint set union
+// =============================
+
+// date:  2026-10-19
+
+#ifndef DISJOINT_SET_H
+#define DISJOINT_SET_H
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <set>
+
+//                          +--------------------+                           //
+// -------------------------+ MODULE DESCRIPTION +-------------------------- //
+//                          +--------------------+                           //
+
+/*
+ * A disjoint set (union find) over the elements 0 .. n - 1. Initially each element is a component of
+ * its own. UnionSets() merges the components of two elements, FindSet() returns the representative
+ * (root) of the component of an element.
+ *
+ *   - union by size: the root of the smaller component is hung under the root of the larger one, so
+ *     the trees stay shallow;
+ *   - path compression: FindSet() lets all elements on the path point directly to the root;
+ *   - the nr of components is kept up to date, so "is everything connected" is a single compare.
+ *
+ * Together this makes any sequence of finds and unions run in near constant time per operation.
+ *
+ * A ConnectivityCurveType records how the components evolve while edges are added in a fixed order
+ * (e.g. Kruskal order: shortest first). Only edges that merge two components change anything, and there
+ * are at most n - 1 of those, so a state is stored per merge, and per edge only the nr of merges so far.
+ * After one pass over the edges, the state after any nr of edges, and the edge at which any component
+ * count is first reached, are answered in constant time.
+ */
+
+//                            +--------------+                               //
+// ---------------------------+ DISJOINT SET +------------------------------ //
+//                            +--------------+                               //
+
+typedef struct {
+    std::vector<int> vParent;     // parent of each element, a root is its own parent
+    std::vector<int> vSize;       // size of the component, only valid for roots
+    int              nComponents; // current nr of components
+} DisjointSetType;
+
+// creates a disjoint set of nElements elements, each in a component of its own
+inline DisjointSetType CreateDisjointSet( int nElements ) {
+    DisjointSetType ds = { std::vector<int>( nElements ), std::vector<int>( nElements, 1 ), nElements };
+    for (int i = 0; i < nElements; i++) {
+        ds.vParent[i] = i;
+    }
+    return ds;
+}
+
+// returns the root of the component that element x is in
+inline int FindSet( DisjointSetType &ds, int x ) {
+    int nRoot = x;
+    while (ds.vParent[nRoot] != nRoot) {
+        nRoot = ds.vParent[nRoot];
+    }
+    // second pass: let all elements on the path point to the root
+    while (ds.vParent[x] != nRoot) {
+        int nNext = ds.vParent[x];
+        ds.vParent[x] = nRoot;
+        x = nNext;
+    }
+    return nRoot;
+}
+
+// Merges the components of elements a and b. Returns true if they were in different components,
+// false if they were already connected.
+inline bool UnionSets( DisjointSetType &ds, int a, int b ) {
+    int nRootA = FindSet( ds, a );
+    int nRootB = FindSet( ds, b );
+    if (nRootA == nRootB) {
+        return false;
+    }
+    if (ds.vSize[nRootA] < ds.vSize[nRootB]) {
+        std::swap( nRootA, nRootB );
+    }
+    ds.vParent[nRootB] = nRootA;
+    ds.vSize[nRootA] += ds.vSize[nRootB];
+    ds.nComponents -= 1;
+    return true;
+}
+
+// returns the size of the component that element x is in
+inline int ComponentSize( DisjointSetType &ds, int x ) {
+    return ds.vSize[FindSet( ds, x )];
+}
+
+// returns true if all elements are in a single component
+inline bool AllConnected( const DisjointSetType &ds ) {
+    return ds.nComponents <= 1;
+}
+
+// returns the sizes of the (at most) nTop largest components, largest first
+inline std::vector<int> LargestComponentSizes( const DisjointSetType &ds, int nTop ) {
+    std::vector<int> vSizes;
+    vSizes.reserve( ds.nComponents );
+    for (int i = 0; i < (int)ds.vParent.size(); i++) {
+        if (ds.vParent[i] == i) {
+            vSizes.push_back( ds.vSize[i] );
+        }
+    }
+    nTop = std::min( nTop, (int)vSizes.size());
+    std::partial_sort( vSizes.begin(), vSizes.begin() + nTop, vSizes.end(), std::greater<int>());
+    vSizes.resize( nTop );
+    return vSizes;
+}
+
+//                         +--------------------+                            //
+// ------------------------+ CONNECTIVITY CURVE +--------------------------- //
+//                         +--------------------+                            //
+
+// the state of the components at some point of the curve
+typedef struct {
+    int       nComponents;    // nr of components
+    int       nLargest;       // size of the largest component
+    long long llTop3;         // product of the sizes of the three largest components
+} ConnectivityType;
+
+typedef struct {
+    DisjointSetType               ds;
+    std::multiset<int>            sSizes;      // sizes of the components with more than 1 element
+    std::vector<ConnectivityType> vStates;     // vStates[m] is the state after m merges
+    std::vector<int>              vMergeEdge;  // vMergeEdge[m] is the index of the edge that did merge m + 1
+    std::vector<int>              vMerges;     // vMerges[k] is the nr of merges by the first k edges
+} ConnectivityCurveType;
+
+// returns the current state of the components of curve
+inline ConnectivityType CurrentConnectivity( const ConnectivityCurveType &curve ) {
+    // components of size 1 are not in sSizes, so missing entries count as 1
+    long long llTop3 = 1;
+    int nLargest = curve.sSizes.empty() ? 1 : *curve.sSizes.rbegin();
+    auto iter = curve.sSizes.rbegin();
+    for (int i = 0; i < 3 && iter != curve.sSizes.rend(); i++, iter++) {
+        llTop3 *= *iter;
+    }
+    return { curve.ds.nComponents, nLargest, llTop3 };
+}
+
+// creates a curve for nElements elements, without any edges added
+inline ConnectivityCurveType CreateConnectivityCurve( int nElements ) {
+    ConnectivityCurveType curve;
+    curve.ds = CreateDisjointSet( nElements );
+    curve.vMerges.push_back( 0 );
+    curve.vStates.push_back( CurrentConnectivity( curve ));
+    return curve;
+}
+
+// Adds the edge (a, b) as the next edge of the curve. Returns true if it merged two components.
+inline bool AddCurveEdge( ConnectivityCurveType &curve, int a, int b ) {
+    int nRootA = FindSet( curve.ds, a );
+    int nRootB = FindSet( curve.ds, b );
+    bool bMerged = (nRootA != nRootB);
+    if (bMerged) {
+        // replace the two merged sizes by their sum
+        for (int nSize : { curve.ds.vSize[nRootA], curve.ds.vSize[nRootB] }) {
+            if (nSize > 1) {
+                curve.sSizes.erase( curve.sSizes.find( nSize ));
+            }
+        }
+        UnionSets( curve.ds, nRootA, nRootB );
+        curve.sSizes.insert( curve.ds.vSize[FindSet( curve.ds, nRootA )] );
+        curve.vMergeEdge.push_back( (int)curve.vMerges.size() - 1 );
+        curve.vStates.push_back( CurrentConnectivity( curve ));
+    }
+    curve.vMerges.push_back( (int)curve.vStates.size() - 1 );
+    return bMerged;
+}
+
+// Returns the state after the first k edges of curve. Edges beyond the ones added are assumed not to
+// merge anything (which is true once everything is connected).
+inline ConnectivityType CurveAt( const ConnectivityCurveType &curve, int k ) {
+    k = std::min( k, (int)curve.vMerges.size() - 1 );
+    return curve.vStates[curve.vMerges[k]];
+}
+
+// Returns the index of the edge at which the nr of components first became nComponents, or -1 if
+// that didn't happen by one of the added edges.
+inline int FirstEdgeForComponents( const ConnectivityCurveType &curve, int nComponents ) {
+    // each merge lowers the nr of components by exactly 1
+    int m = (int)curve.ds.vParent.size() - nComponents;
+    return (m >= 1 && m <= (int)curve.vMergeEdge.size()) ? curve.vMergeEdge[m - 1] : -1;
+}
+
+#endif // DISJOINT_SET_H
@@ -0,0 +1,149 @@
+// AoC 2025 - euclidean minimum spanning tree
+// ==========================================
+
+// date:  2026-10-19
+
+#ifndef EUCLIDEAN_MST_H
+#define EUCLIDEAN_MST_H
+
+#include <vector>
+#include <atomic>
+#include <climits>
+#include <algorithm>
+
+#include "vector_types.h"
+#include "thread_pool.h"
+#include "closest_pairs.h"
+#include "kd_tree.h"
+#include "disjoint_set.h"
+
+//                          +--------------------+                           //
+// -------------------------+ MODULE DESCRIPTION +-------------------------- //
+//                          +--------------------+                           //
+
+/*
+ * The minimum spanning tree of the complete graph over n vi3d points, where the weight of pair (i, j)
+ * is the squared distance (as an integer). The pair list is never built: this is Boruvka's algorithm,
+ * using the k-d tree of kd_tree.h for the nearest neighbour searches.
+ *
+ * Each round, every component picks its cheapest edge to another component, and all those edges are
+ * added. That at least halves the nr of components, so there are at most log2( n ) rounds. A round:
+ *   - labels each node of the k-d tree with the component of its subtree, if all its points are in the
+ *     same component (-1 otherwise). A search skips subtrees that lie entirely in its own component;
+ *   - searches for each point its nearest point in another component. The points are independent, so
+ *     this is a parallel loop on the thread pool. Each component keeps the smallest distance found so
+ *     far by any of its points (an atomic minimum), and the searches use it as an extra bound;
+ *   - picks the cheapest edge per component, and adds those edges with a disjoint set.
+ *
+ * A round takes about O(n log n) time for evenly spread points, so the whole tree takes about
+ * O(n log^2 n) time and O(n) memory, which is fine for 10^5 - 10^6 points.
+ *
+ * Edges are compared on (distance, i, j) with PairLess() from closest_pairs.h. That is a strict order,
+ * so the tree is unique, and it is the same tree that adding the pairs in that order (Kruskal) gives.
+ * The edges are returned in that order, so the last edge is the one that connects everything.
+ */
+
+// nr of points per parallel task of a Boruvka round
+#define MST_GRAIN  1024
+
+// Sets vLabel[mid] for each node mid of the subtree [ lo, hi ) to the component that all its points are
+// in (or -1 if there is more than one), and returns the label of the subtree (-2 if it is empty).
+// vComp holds the component of each point, by original index.
+inline int LabelKdRange( const KdTreeType &tree, const std::vector<int> &vComp, int lo, int hi, std::vector<int> &vLabel ) {
+    if (hi - lo <= 0) {
+        return -2;
+    }
+    int mid = (lo + hi) / 2;
+    int nLabel = vComp[tree.vIndex[mid]];
+    int nLeft  = LabelKdRange( tree, vComp, lo, mid, vLabel );
+    int nRight = LabelKdRange( tree, vComp, mid + 1, hi, vLabel );
+    if ((nLeft != -2 && nLeft != nLabel) || (nRight != -2 && nRight != nLabel)) {
+        nLabel = -1;
+    }
+    vLabel[mid] = nLabel;
+    return nLabel;
+}
+
+// Searches the subtree [ lo, hi ) for the cheapest edge from point nI (at q, in component nComp) to a
+// point in another component, into best. Subtrees beyond llBound (or beyond best) are skipped.
+inline void NearestOtherRange( const KdTreeType &tree, const std::vector<int> &vComp, const std::vector<int> &vLabel,
+                               int lo, int hi, int nI, const vi3d &q, int nComp, long long llBound, PairEdgeType &best ) {
+    if (hi - lo <= 0) {
+        return;
+    }
+    int mid = (lo + hi) / 2;
+    if (vLabel[mid] == nComp) {
+        return;
+    }
+    int j = tree.vIndex[mid];
+    if (vComp[j] != nComp) {
+        PairEdgeType e = { std::min( nI, j ), std::max( nI, j ), KdDist2( q, tree.vPoints[mid] ) };
+        if (PairLess( e, best )) {
+            best = e;
+        }
+    }
+    // search the side of q first, and the other side only if it can hold a cheaper edge
+    long long llDelta = (long long)KdCoord( q, tree.vAxis[mid] ) - KdCoord( tree.vPoints[mid], tree.vAxis[mid] );
+    bool bLeftFirst = (llDelta < 0);
+    NearestOtherRange( tree, vComp, vLabel, bLeftFirst ? lo : mid + 1, bLeftFirst ? mid : hi, nI, q, nComp, llBound, best );
+    if (llDelta * llDelta <= std::min( llBound, best.llDist2 )) {
+        NearestOtherRange( tree, vComp, vLabel, bLeftFirst ? mid + 1 : lo, bLeftFirst ? hi : mid, nI, q, nComp, llBound, best );
+    }
+}
+
+// Returns the n - 1 edges of the minimum spanning tree of the points vPoints, in increasing order
+inline PairEdgeStream EuclideanMst( const std::vector<vi3d> &vPoints ) {
+    PairEdgeStream vResult;
+    int nPoints = vPoints.size();
+    if (nPoints < 2) {
+        return vResult;
+    }
+    const PairEdgeType noEdge = { -1, -1, LLONG_MAX };
+    KdTreeType tree = BuildKdTree( vPoints );
+    DisjointSetType ds = CreateDisjointSet( nPoints );
+    std::vector<int> vComp( nPoints ), vLabel( nPoints );
+    PairEdgeStream vNearest( nPoints );                       // per point: its cheapest edge to another component
+    std::vector<std::atomic<long long>> vBound( nPoints );    // per component: smallest distance found so far
+    vResult.reserve( nPoints - 1 );
+
+    while (!AllConnected( ds )) {
+        for (int i = 0; i < nPoints; i++) {
+            vComp[i] = FindSet( ds, i );
+            vBound[i] = LLONG_MAX;
+        }
+        LabelKdRange( tree, vComp, 0, nPoints, vLabel );
+        ParallelFor(
+            0, nPoints,
+            [&]( long long lo, long long hi ) {
+                for (int i = lo; i < hi; i++) {
+                    int nComp = vComp[i];
+                    vNearest[i] = noEdge;
+                    NearestOtherRange( tree, vComp, vLabel, 0, nPoints, i, vPoints[i], nComp, vBound[nComp], vNearest[i] );
+                    // lower the bound of the component, if this point found a nearer other component
+                    long long llBound = vBound[nComp];
+                    while (vNearest[i].llDist2 < llBound && !vBound[nComp].compare_exchange_weak( llBound, vNearest[i].llDist2 )) {
+                    }
+                }
+            },
+            MST_GRAIN
+        );
+        // the cheapest edge per component - because of the bound, a point may miss its own cheapest edge,
+        // but never the cheapest edge of its component
+        PairEdgeStream vCompBest( nPoints, noEdge );
+        for (int i = 0; i < nPoints; i++) {
+            if (PairLess( vNearest[i], vCompBest[vComp[i]] )) {
+                vCompBest[vComp[i]] = vNearest[i];
+            }
+        }
+        // an edge that is the cheapest of both its components is only added once
+        for (auto &e : vCompBest) {
+            if (e.nA >= 0 && UnionSets( ds, e.nA, e.nB )) {
+                vResult.push_back( e );
+            }
+        }
+    }
+    std::sort( vResult.begin(), vResult.end(), PairLess );
+    return vResult;
+}
+
+#endif // EUCLIDEAN_MST_H
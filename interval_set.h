@@ -0,0 +1,113 @@
+// AoC 2025 - interval set operations
+// ==================================
+
+// date:  2026-10-19
+
+#ifndef INTERVAL_SET_H
+#define INTERVAL_SET_H
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+//                          +--------------------+                           //
+// -------------------------+ MODULE DESCRIPTION +-------------------------- //
+//                          +--------------------+                           //
+
+/*
+ * Operations on lists of integer ranges. The range type R can be any struct with integer members
+ * low and hgh, that are the (inclusive) boundaries of the range, like:
+ *
+ *     typedef struct {
+ *         long long low, hgh;
+ *     } RangeType;
+ *
+ * A "merged" range list is sorted on low, and its ranges are disjoint and not adjacent - i.e. there
+ * is at least one value between two consecutive ranges. MergeRanges() turns any list into a merged
+ * one by sorting it and then merging it in a single linear sweep. The other operations expect merged
+ * lists as input, produce merged lists as output, and take linear time.
+ */
+
+// returns true if range b overlaps with or is adjacent to range a - ASSUMPTION: a.low <= b.low
+template <class R>
+bool IsMergeable( const R &a, const R &b ) {
+    // written as b.low - 1 <= a.hgh, so that a.hgh + 1 can't overflow
+    return b.low - 1 <= a.hgh;
+}
+
+// Sweeps over the ranges of the sorted list vSorted, and returns the merged list
+template <class R>
+std::vector<R> SweepRanges( const std::vector<R> &vSorted ) {
+    std::vector<R> vResult;
+    for (auto &r : vSorted) {
+        if (!vResult.empty() && IsMergeable( vResult.back(), r )) {
+            vResult.back().hgh = std::max( vResult.back().hgh, r.hgh );
+        } else {
+            vResult.push_back( r );
+        }
+    }
+    return vResult;
+}
+
+// returns the merged version of range list vRanges (which may be unsorted and overlapping)
+template <class R>
+std::vector<R> MergeRanges( std::vector<R> vRanges ) {
+    std::sort(
+        vRanges.begin(),
+        vRanges.end(),
+        []( const R &a, const R &b ) {
+            return a.low < b.low;
+        }
+    );
+    return SweepRanges( vRanges );
+}
+
+// returns the union of the merged range lists a and b, as a merged list
+template <class R>
+std::vector<R> UnionRanges( const std::vector<R> &a, const std::vector<R> &b ) {
+    std::vector<R> vSorted;
+    vSorted.reserve( a.size() + b.size());
+    std::merge(
+        a.begin(), a.end(),
+        b.begin(), b.end(),
+        std::back_inserter( vSorted ),
+        []( const R &r1, const R &r2 ) {
+            return r1.low < r2.low;
+        }
+    );
+    return SweepRanges( vSorted );
+}
+
+// returns the intersection of the merged range lists a and b, as a merged list
+template <class R>
+std::vector<R> IntersectRanges( const std::vector<R> &a, const std::vector<R> &b ) {
+    std::vector<R> vResult;
+    int i = 0, j = 0;
+    while (i < (int)a.size() && j < (int)b.size()) {
+        R r = a[i];
+        r.low = std::max( a[i].low, b[j].low );
+        r.hgh = std::min( a[i].hgh, b[j].hgh );
+        if (r.low <= r.hgh) {
+            vResult.push_back( r );
+        }
+        // advance past the range that ends first
+        if (a[i].hgh < b[j].hgh) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+    return vResult;
+}
+
+// returns the total nr of values that is covered by the merged range list vRanges
+template <class R>
+long long RangeCoverage( const std::vector<R> &vRanges ) {
+    long long llTotal = 0;
+    for (auto &r : vRanges) {
+        llTotal += r.hgh - r.low + 1;
+    }
+    return llTotal;
+}
+
+#endif // INTERVAL_SET_H
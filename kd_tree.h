@@ -0,0 +1,249 @@
+// AoC 2025 - k-d tree for 3d neighbour queries
+// ============================================
+
+// date:  2026-10-19
+
+#ifndef KD_TREE_H
+#define KD_TREE_H
+
+#include <vector>
+#include <queue>
+#include <climits>
+#include <algorithm>
+
+#include "vector_types.h"
+#include "thread_pool.h"
+#include "closest_pairs.h"
+
+//                          +--------------------+                           //
+// -------------------------+ MODULE DESCRIPTION +-------------------------- //
+//                          +--------------------+                           //
+
+/*
+ * A k-d tree over a set of vi3d points, for nearest neighbour queries with exact (squared, integer)
+ * distances.
+ *
+ * The tree is implicit and balanced: the points are stored in tree order, and the node of a range
+ * [ lo, hi ) of positions is the median position (lo + hi) / 2, that splits the range on the axis
+ * with the largest spread. Building takes O(n log n) time, and needs no pointers.
+ *
+ *   - KNearest()  - the k nearest points to a query point, using a bounded max heap. A subtree is
+ *                   only searched if the distance to its splitting plane can beat the heap top;
+ *   - InRadius()  - all points within a (squared) radius of a query point;
+ *   - the closest pair traversal hands out all pairs (i, j) of the point set in increasing order of
+ *     (distance, i, j) - the same order as closest_pairs.h. Each point i keeps a list of its nearest
+ *     points j > i, and the head of each list sits in a global min heap. Popping the heap gives the
+ *     next pair, and when a list runs out it is fetched again with twice as many neighbours. The
+ *     first m pairs take about O((n + m) log n) time, instead of O(n^2) for all pairs.
+ */
+
+// a neighbour of a query point, with its index in the original point set
+typedef struct {
+    long long llDist2;
+    int       nIndex;
+} NeighbourType;
+typedef std::vector<NeighbourType> NeighbourStream;
+
+// returns true if neighbour a is smaller than neighbour b, on (distance, index)
+inline bool NeighbourLess( const NeighbourType &a, const NeighbourType &b ) {
+    return a.llDist2 != b.llDist2 ? a.llDist2 < b.llDist2 : a.nIndex < b.nIndex;
+}
+
+typedef struct {
+    std::vector<vi3d>          vPoints;   // the points in tree order
+    std::vector<int>           vIndex;    // original index of the point at each tree position
+    std::vector<unsigned char> vAxis;     // split axis of the node at each tree position
+} KdTreeType;
+
+// returns coordinate nAxis (0 = x, 1 = y, 2 = z) of p
+inline int KdCoord( const vi3d &p, int nAxis ) {
+    return nAxis == 0 ? p.x : (nAxis == 1 ? p.y : p.z);
+}
+
+// returns the squared distance between a and b
+inline long long KdDist2( const vi3d &a, const vi3d &b ) {
+    long long dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+// orders the positions [ lo, hi ) of vOrder into a (sub)tree, using the points in vPoints
+inline void BuildKdRange( const std::vector<vi3d> &vPoints, std::vector<int> &vOrder, std::vector<unsigned char> &vAxis, int lo, int hi ) {
+    if (hi - lo <= 0) {
+        return;
+    }
+    // split on the axis with the largest spread
+    int vMin[3] = { INT_MAX, INT_MAX, INT_MAX }, vMax[3] = { INT_MIN, INT_MIN, INT_MIN };
+    for (int i = lo; i < hi; i++) {
+        for (int a = 0; a < 3; a++) {
+            vMin[a] = std::min( vMin[a], KdCoord( vPoints[vOrder[i]], a ));
+            vMax[a] = std::max( vMax[a], KdCoord( vPoints[vOrder[i]], a ));
+        }
+    }
+    int nAxis = 0;
+    for (int a = 1; a < 3; a++) {
+        if ((long long)vMax[a] - vMin[a] > (long long)vMax[nAxis] - vMin[nAxis]) {
+            nAxis = a;
+        }
+    }
+    int mid = (lo + hi) / 2;
+    std::nth_element(
+        vOrder.begin() + lo, vOrder.begin() + mid, vOrder.begin() + hi,
+        [&]( int a, int b ) {
+            return KdCoord( vPoints[a], nAxis ) < KdCoord( vPoints[b], nAxis );
+        }
+    );
+    vAxis[mid] = nAxis;
+    BuildKdRange( vPoints, vOrder, vAxis, lo, mid );
+    BuildKdRange( vPoints, vOrder, vAxis, mid + 1, hi );
+}
+
+// builds and returns the k-d tree for the points in vPoints
+inline KdTreeType BuildKdTree( const std::vector<vi3d> &vPoints ) {
+    KdTreeType tree;
+    tree.vIndex.resize( vPoints.size());
+    tree.vAxis.assign( vPoints.size(), 0 );
+    for (int i = 0; i < (int)vPoints.size(); i++) {
+        tree.vIndex[i] = i;
+    }
+    BuildKdRange( vPoints, tree.vIndex, tree.vAxis, 0, vPoints.size());
+    for (int i : tree.vIndex) {
+        tree.vPoints.push_back( vPoints[i] );
+    }
+    return tree;
+}
+
+// searches the subtree [ lo, hi ) for the nK nearest points to q with index > nMinIndex, into max heap vHeap
+inline void KNearestRange( const KdTreeType &tree, int lo, int hi, const vi3d &q, int nK, int nMinIndex, NeighbourStream &vHeap ) {
+    if (hi - lo <= 0) {
+        return;
+    }
+    int mid = (lo + hi) / 2;
+    if (tree.vIndex[mid] > nMinIndex) {
+        NeighbourType n = { KdDist2( q, tree.vPoints[mid] ), tree.vIndex[mid] };
+        if ((int)vHeap.size() < nK) {
+            vHeap.push_back( n );
+            std::push_heap( vHeap.begin(), vHeap.end(), NeighbourLess );
+        } else if (NeighbourLess( n, vHeap.front())) {
+            std::pop_heap( vHeap.begin(), vHeap.end(), NeighbourLess );
+            vHeap.back() = n;
+            std::push_heap( vHeap.begin(), vHeap.end(), NeighbourLess );
+        }
+    }
+    // search the side of q first, and the other side only if it can hold a nearer point
+    long long llDelta = (long long)KdCoord( q, tree.vAxis[mid] ) - KdCoord( tree.vPoints[mid], tree.vAxis[mid] );
+    bool bLeftFirst = (llDelta < 0);
+    KNearestRange( tree, bLeftFirst ? lo : mid + 1, bLeftFirst ? mid : hi, q, nK, nMinIndex, vHeap );
+    if ((int)vHeap.size() < nK || llDelta * llDelta <= vHeap.front().llDist2) {
+        KNearestRange( tree, bLeftFirst ? mid + 1 : lo, bLeftFirst ? hi : mid, q, nK, nMinIndex, vHeap );
+    }
+}
+
+// Returns the (at most) nK nearest points to q that have an original index > nMinIndex, nearest first.
+// Use nMinIndex = -1 to consider all points.
+inline NeighbourStream KNearest( const KdTreeType &tree, const vi3d &q, int nK, int nMinIndex = -1 ) {
+    NeighbourStream vHeap;
+    vHeap.reserve( nK );
+    KNearestRange( tree, 0, tree.vPoints.size(), q, nK, nMinIndex, vHeap );
+    std::sort_heap( vHeap.begin(), vHeap.end(), NeighbourLess );
+    return vHeap;
+}
+
+// adds the points of subtree [ lo, hi ) within squared distance llRadius2 of q to vResult
+inline void InRadiusRange( const KdTreeType &tree, int lo, int hi, const vi3d &q, long long llRadius2, NeighbourStream &vResult ) {
+    if (hi - lo <= 0) {
+        return;
+    }
+    int mid = (lo + hi) / 2;
+    long long llDist2 = KdDist2( q, tree.vPoints[mid] );
+    if (llDist2 <= llRadius2) {
+        vResult.push_back( { llDist2, tree.vIndex[mid] } );
+    }
+    long long llDelta = (long long)KdCoord( q, tree.vAxis[mid] ) - KdCoord( tree.vPoints[mid], tree.vAxis[mid] );
+    if (llDelta <= 0 || llDelta * llDelta <= llRadius2) {
+        InRadiusRange( tree, lo, mid, q, llRadius2, vResult );
+    }
+    if (llDelta >= 0 || llDelta * llDelta <= llRadius2) {
+        InRadiusRange( tree, mid + 1, hi, q, llRadius2, vResult );
+    }
+}
+
+// returns all points within squared distance llRadius2 of q, nearest first
+inline NeighbourStream InRadius( const KdTreeType &tree, const vi3d &q, long long llRadius2 ) {
+    NeighbourStream vResult;
+    InRadiusRange( tree, 0, tree.vPoints.size(), q, llRadius2, vResult );
+    std::sort( vResult.begin(), vResult.end(), NeighbourLess );
+    return vResult;
+}
+
+//                        +------------------------+                         //
+// -----------------------+ CLOSEST PAIR TRAVERSAL +------------------------ //
+//                        +------------------------+                         //
+
+// nr of neighbours that is fetched per point at the start of the traversal
+#define KD_PAIR_K0  4
+
+// the min heap holds the next pair of each point, so it compares on "larger than"
+struct PairGreater {
+    bool operator () ( const PairEdgeType &a, const PairEdgeType &b ) const { return PairLess( b, a ); }
+};
+
+typedef struct {
+    const KdTreeType            *pTree;
+    std::vector<vi3d>            vPoints;       // the points in original order
+    std::vector<NeighbourStream> vNeighbours;   // per point i: its nearest points j > i fetched so far
+    std::vector<int>             vNext;         // per point i: position of the next pair in vNeighbours[i]
+    std::priority_queue<PairEdgeType, PairEdgeStream, PairGreater> pqHeads;
+} ClosestPairIterType;
+
+// pushes the next pair of point i onto the heap of iter (if there is one), fetching more neighbours if needed
+inline void PushNextPair( ClosestPairIterType &iter, int i ) {
+    NeighbourStream &vList = iter.vNeighbours[i];
+    if (iter.vNext[i] == (int)vList.size() && !vList.empty()) {
+        // the list is used up - if it was full, there may be more neighbours, so fetch twice as many
+        int nK = vList.size();
+        int nRemaining = (int)iter.vPoints.size() - 1 - i;
+        if (nK < nRemaining) {
+            vList = KNearest( *iter.pTree, iter.vPoints[i], std::min( 2 * nK, nRemaining ), i );
+        }
+    }
+    if (iter.vNext[i] < (int)vList.size()) {
+        const NeighbourType &n = vList[iter.vNext[i]];
+        iter.pqHeads.push( { i, n.nIndex, n.llDist2 } );
+    }
+}
+
+// creates a traversal over all pairs of the points vPoints, that tree was built from
+inline ClosestPairIterType CreateClosestPairIter( const KdTreeType &tree, const std::vector<vi3d> &vPoints ) {
+    ClosestPairIterType iter;
+    iter.pTree = &tree;
+    iter.vPoints = vPoints;
+    iter.vNeighbours.resize( vPoints.size());
+    iter.vNext.assign( vPoints.size(), 0 );
+    // the first neighbour lists are independent, so they are fetched in parallel
+    ParallelFor(
+        0, vPoints.size(),
+        [&]( long long lo, long long hi ) {
+            for (long long i = lo; i < hi; i++) {
+                iter.vNeighbours[i] = KNearest( tree, vPoints[i], KD_PAIR_K0, i );
+            }
+        }
+    );
+    for (int i = 0; i < (int)vPoints.size(); i++) {
+        PushNextPair( iter, i );
+    }
+    return iter;
+}
+
+// Gets the next closest pair of the traversal into e. Returns false if all pairs are handed out.
+inline bool NextClosestPair( ClosestPairIterType &iter, PairEdgeType &e ) {
+    if (iter.pqHeads.empty()) {
+        return false;
+    }
+    e = iter.pqHeads.top();
+    iter.pqHeads.pop();
+    iter.vNext[e.nA] += 1;
+    PushNextPair( iter, e.nA );
+    return true;
+}
+
+#endif // KD_TREE_H
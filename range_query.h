@@ -0,0 +1,105 @@
+// AoC 2025 - membership queries on merged ranges
+// ==============================================
+
+// date:  2026-10-19
+
+#ifndef RANGE_QUERY_H
+#define RANGE_QUERY_H
+
+#include <vector>
+#include <algorithm>
+
+#include "interval_set.h"
+
+//                          +--------------------+                           //
+// -------------------------+ MODULE DESCRIPTION +-------------------------- //
+//                          +--------------------+                           //
+
+/*
+ * Fast "is value x in any of the ranges" queries, against a merged range list (see interval_set.h).
+ *
+ * Single queries use a RangeIndexType: the ranges are stored in Eytzinger order, i.e. laid out like a
+ * binary heap (the children of node k are 2k and 2k + 1). A search then walks down the tree without
+ * branches, and the first levels of the tree share a few cache lines. The search finds the first range
+ * with hgh >= x, and x is in the ranges if that range has low <= x.
+ *
+ * For large batches of values, CountInRangesSorted() is an alternative: it sorts the values and walks
+ * them together with the range list, in a single merge join.
+ *
+ * Both work on a const index / range list, so batches can be split over threads freely.
+ */
+
+// the ranges of a merged range list, in Eytzinger order (1 based - element 0 is unused)
+typedef struct {
+    int                    nSize;
+    std::vector<long long> vLow;
+    std::vector<long long> vHgh;
+} RangeIndexType;
+
+// fills the index positions k, 2k, 2k + 1, ... in order from the sorted ranges, starting at nNext
+template <class R>
+void FillEytzinger( const std::vector<R> &vMerged, RangeIndexType &index, int &nNext, int k ) {
+    if (k <= index.nSize) {
+        FillEytzinger( vMerged, index, nNext, 2 * k );
+        index.vLow[k] = vMerged[nNext].low;
+        index.vHgh[k] = vMerged[nNext].hgh;
+        nNext += 1;
+        FillEytzinger( vMerged, index, nNext, 2 * k + 1 );
+    }
+}
+
+// builds the query index for the merged range list vMerged
+template <class R>
+RangeIndexType BuildRangeIndex( const std::vector<R> &vMerged ) {
+    RangeIndexType index;
+    index.nSize = vMerged.size();
+    index.vLow.assign( index.nSize + 1, 0 );
+    index.vHgh.assign( index.nSize + 1, 0 );
+    int nNext = 0;
+    FillEytzinger( vMerged, index, nNext, 1 );
+    return index;
+}
+
+// returns true if x is in one of the ranges of index
+inline bool IsInRanges( const RangeIndexType &index, long long x ) {
+    const long long *pHgh = index.vHgh.data();
+    unsigned k = 1;
+    while (k <= (unsigned)index.nSize) {
+        // the 8 descendants of k three levels down are stored next to each other - fetch them ahead of time
+        __builtin_prefetch( pHgh + 8 * k );
+        k = 2 * k + (pHgh[k] < x);
+    }
+    // the answer is the node where the path last went left: strip the trailing right turns (1 bits) and that left turn
+    k >>= __builtin_ffs( ~k );
+    return k != 0 && index.vLow[k] <= x;
+}
+
+// returns the nr of values in vValues[nFrom] .. vValues[nTo - 1] that are in one of the ranges of index
+inline long long CountInRanges( const RangeIndexType &index, const long long *vValues, long long nFrom, long long nTo ) {
+    long long llCount = 0;
+    for (long long i = nFrom; i < nTo; i++) {
+        llCount += IsInRanges( index, vValues[i] ) ? 1 : 0;
+    }
+    return llCount;
+}
+
+// returns the nr of values in vValues that are in one of the ranges of merged range list vMerged,
+// by sorting the values and merge joining them with the ranges
+template <class R>
+long long CountInRangesSorted( const std::vector<R> &vMerged, std::vector<long long> vValues ) {
+    std::sort( vValues.begin(), vValues.end());
+    long long llCount = 0;
+    int j = 0;
+    for (long long x : vValues) {
+        while (j < (int)vMerged.size() && vMerged[j].hgh < x) {
+            j++;
+        }
+        if (j == (int)vMerged.size()) {
+            break;
+        }
+        llCount += (vMerged[j].low <= x) ? 1 : 0;
+    }
+    return llCount;
+}
+
+#endif // RANGE_QUERY_H
@@ -0,0 +1,68 @@
+// AoC 2025 - part runner utility
+// ==============================
+
+// date:  2026-10-19
+
+#ifndef RUN_PARTS_H
+#define RUN_PARTS_H
+
+#include <iostream>
+#include <future>
+#include <utility>
+
+#include "../flcTimer.h"
+
+//                          +--------------------+                           //
+// -------------------------+ MODULE DESCRIPTION +-------------------------- //
+//                          +--------------------+                           //
+
+/*
+ * The two parts of a puzzle are independent once the input data is parsed. RunParts() takes a
+ * solver function for each part, and runs them either one after the other, or concurrently as
+ * parallel tasks. In both cases each part is timed with its own flcTimer, so the timing per part
+ * is reported the same way, regardless of the execution mode.
+ *
+ * NOTE: for the concurrent mode to be safe, both parts may only share read only data!
+ */
+
+// the result of solving one part: the answer and the time it took to get it (in milli seconds)
+template <class T>
+struct PartResult {
+    T      answer;
+    double dTiming;
+};
+
+// calls fnPart, and returns its answer together with the time the call took
+template <class F>
+auto TimedPart( F &fnPart ) -> PartResult<decltype( fnPart() )> {
+    flcTimer tmr;
+    tmr.StartTiming();
+    auto answer = fnPart();
+    return { answer, tmr.TimeDuration() };
+}
+
+// Solves part 1 and part 2 by calling fnPart1 and fnPart2 and returns their results as a pair.
+// If bConcurrent is true, part 1 is launched as a separate task, while part 2 runs on the calling
+// thread. Both are joined before the results are returned.
+template <class F1, class F2>
+auto RunParts( F1 fnPart1, F2 fnPart2, bool bConcurrent )
+    -> std::pair<decltype( TimedPart( fnPart1 )), decltype( TimedPart( fnPart2 ))> {
+
+    if (bConcurrent) {
+        auto futPart1 = std::async( std::launch::async, [&]() { return TimedPart( fnPart1 ); } );
+        auto resPart2 = TimedPart( fnPart2 );
+        return { futPart1.get(), resPart2 };
+    }
+    auto resPart1 = TimedPart( fnPart1 );
+    auto resPart2 = TimedPart( fnPart2 );
+    return { resPart1, resPart2 };
+}
+
+// reports the answer and the timing of part nPart, formatted like the other console output of the puzzles
+template <class T>
+void ReportPart( const std::string &sDay, int nPart, const PartResult<T> &res ) {
+    std::cout << std::endl << "Answer to " << sDay << " part " << nPart << ": " << res.answer << std::endl << std::endl;
+    std::cout << "    Timing " << nPart << " - solving puzzle part " << nPart << ": " << res.dTiming << " msec" << std::endl;
+}
+
+#endif // RUN_PARTS_H
@@ -0,0 +1,275 @@
+// AoC 2025 - work stealing thread pool
+// ====================================
+
+// date:  2026-10-19
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+#include <algorithm>
+
+//                          +--------------------+                           //
+// -------------------------+ MODULE DESCRIPTION +-------------------------- //
+//                          +--------------------+                           //
+
+/*
+ * A small work stealing thread pool, to be shared by all days. Each worker thread owns a deque of
+ * tasks. It pops work from the back of its own deque, and if that is empty it steals from the front
+ * of the deques of the other workers.
+ *
+ * On top of the pool there are three building blocks:
+ *   - TaskGroup      - a set of tasks that can be waited for. A waiting thread helps executing
+ *                      pending tasks, so task groups can be nested safely. Only when there is nothing
+ *                      left to help with, it blocks until a task of the group finishes;
+ *   - ParallelFor    - calls a function for each chunk of an index range [ nBegin, nEnd );
+ *   - ParallelReduce - like ParallelFor, but each chunk returns a partial result. The chunks only
+ *                      depend on the range and the grain size (not on the number of threads), and
+ *                      the partial results are combined in index order. This way the result is
+ *                      bitwise reproducible, regardless of the number of cores or the scheduling.
+ *
+ * GlobalPool() returns a pool with one thread per core, that is created on first use.
+ */
+
+//                              +------------+                               //
+// -----------------------------+ THREADPOOL +------------------------------ //
+//                              +------------+                               //
+
+typedef std::function<void()> TaskType;
+
+class ThreadPool {
+
+public:
+    // nThreads == 0 means: use one thread per hardware core
+    explicit ThreadPool( int nThreads = 0 ) : vQueues( DefaultNrThreads( nThreads )) {
+        nThreads = (int)vQueues.size();
+        for (int i = 0; i < nThreads; i++) {
+            vWorkers.emplace_back( [this, i]() { WorkerLoop( i ); } );
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock( mtxSleep );
+            bStopping = true;
+        }
+        cvSleep.notify_all();
+        for (auto &t : vWorkers) {
+            t.join();
+        }
+    }
+
+    ThreadPool( const ThreadPool & ) = delete;
+    ThreadPool &operator = ( const ThreadPool & ) = delete;
+
+    int NrThreads() const { return (int)vWorkers.size(); }
+
+    // puts a task in the queue of the calling worker, or - if called from outside the pool -
+    // distributes it round robin over the worker queues
+    void Submit( TaskType task ) {
+        int nQ = (nMyIndex >= 0 && pMyPool == this) ? nMyIndex : (int)(nNextQueue++ % vQueues.size());
+        {
+            std::lock_guard<std::mutex> lock( vQueues[nQ].mtx );
+            vQueues[nQ].dTasks.push_back( std::move( task ));
+        }
+        {
+            std::lock_guard<std::mutex> lock( mtxSleep );
+            nPending++;
+        }
+        cvSleep.notify_one();
+    }
+
+    // tries to get a task (own queue first, then steal) and run it - returns false if no task was found
+    bool RunPendingTask() {
+        TaskType task;
+        if (!GetTask( task )) {
+            return false;
+        }
+        task();
+        return true;
+    }
+
+private:
+    struct WorkQueue {
+        std::mutex           mtx;
+        std::deque<TaskType> dTasks;
+    };
+
+    std::vector<WorkQueue>   vQueues;
+    std::vector<std::thread> vWorkers;
+    std::atomic<unsigned>    nNextQueue{ 0 };
+
+    std::mutex               mtxSleep;
+    std::condition_variable  cvSleep;
+    int                      nPending  = 0;
+    bool                     bStopping = false;
+
+    // identification of the worker thread (if any) that is running the code
+    static inline thread_local int         nMyIndex = -1;
+    static inline thread_local ThreadPool *pMyPool  = nullptr;
+
+    static int DefaultNrThreads( int nThreads ) {
+        return nThreads > 0 ? nThreads : std::max( 1, (int)std::thread::hardware_concurrency());
+    }
+
+    bool GetTask( TaskType &task ) {
+        int nQueues = (int)vQueues.size();
+        int nStart  = (nMyIndex >= 0 && pMyPool == this) ? nMyIndex : 0;
+        for (int i = 0; i < nQueues; i++) {
+            int nQ = (nStart + i) % nQueues;
+            WorkQueue &q = vQueues[nQ];
+            std::lock_guard<std::mutex> lock( q.mtx );
+            if (!q.dTasks.empty()) {
+                // own queue: take newest task (LIFO), other queue: steal oldest task (FIFO)
+                if (i == 0 && nQ == nMyIndex && pMyPool == this) {
+                    task = std::move( q.dTasks.back());
+                    q.dTasks.pop_back();
+                } else {
+                    task = std::move( q.dTasks.front());
+                    q.dTasks.pop_front();
+                }
+                std::lock_guard<std::mutex> lockSleep( mtxSleep );
+                nPending--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WorkerLoop( int nIndex ) {
+        nMyIndex = nIndex;
+        pMyPool  = this;
+        while (true) {
+            if (RunPendingTask()) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock( mtxSleep );
+            cvSleep.wait( lock, [this]() { return bStopping || nPending > 0; } );
+            if (bStopping && nPending == 0) {
+                return;
+            }
+        }
+    }
+};
+
+// returns the pool that is shared by all users in the program
+inline ThreadPool &GlobalPool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+//                              +-----------+                                //
+// -----------------------------+ TASKGROUP +------------------------------- //
+//                              +-----------+                                //
+
+// A set of tasks that is run on a pool, and that can be waited for with Wait().
+// While waiting, the calling thread executes pending tasks itself, and it blocks only when there
+// are no pending tasks left, while the tasks of the group are still running on other threads.
+class TaskGroup {
+
+public:
+    explicit TaskGroup( ThreadPool &p = GlobalPool()) : pool( p ) {}
+    ~TaskGroup() { Wait(); }
+
+    template <class F>
+    void Run( F fnTask ) {
+        nBusy++;
+        pool.Submit( [this, fnTask]() {
+            fnTask();
+            // decrement under the lock, so that Wait() can't return (and the group can't be
+            // destroyed) before this task is done with the group
+            std::lock_guard<std::mutex> lock( mtxDone );
+            nBusy--;
+            cvDone.notify_all();
+        } );
+    }
+
+    void Wait() {
+        while (true) {
+            if (pool.RunPendingTask()) {
+                continue;
+            }
+            // nothing to help with - sleep until a task of the group finishes, then look again
+            std::unique_lock<std::mutex> lock( mtxDone );
+            if (nBusy == 0) {
+                return;
+            }
+            cvDone.wait( lock );
+        }
+    }
+
+private:
+    ThreadPool              &pool;
+    std::atomic<int>         nBusy{ 0 };
+    std::mutex               mtxDone;
+    std::condition_variable  cvDone;
+};
+
+//                           +-----------------+                             //
+// --------------------------+ PARALLEL LOOPS  +---------------------------- //
+//                           +-----------------+                             //
+
+// default grain size: the range is cut into roughly this many chunks per thread, to balance the load
+#define POOL_CHUNKS_PER_THREAD  4
+
+// returns the chunk size to use for a range of nCount elements
+inline long long PoolGrainSize( long long nCount, ThreadPool &pool = GlobalPool()) {
+    long long nChunks = (long long)pool.NrThreads() * POOL_CHUNKS_PER_THREAD;
+    return std::max( 1LL, (nCount + nChunks - 1) / nChunks );
+}
+
+// Calls fnChunk( lo, hi ) for consecutive chunks of the range [ nBegin, nEnd ), of nGrain
+// elements each (the last chunk may be smaller), and returns when all chunks are processed.
+// If nGrain <= 0 the grain size is derived from the number of threads in the pool.
+template <class F>
+void ParallelFor( long long nBegin, long long nEnd, F fnChunk, long long nGrain = 0, ThreadPool &pool = GlobalPool()) {
+    if (nEnd <= nBegin) {
+        return;
+    }
+    if (nGrain <= 0) {
+        nGrain = PoolGrainSize( nEnd - nBegin, pool );
+    }
+    TaskGroup tg( pool );
+    for (long long lo = nBegin; lo < nEnd; lo += nGrain) {
+        long long hi = std::min( nEnd, lo + nGrain );
+        tg.Run( [&fnChunk, lo, hi]() { fnChunk( lo, hi ); } );
+    }
+    tg.Wait();
+}
+
+// Calls fnChunk( lo, hi ) -> T for consecutive chunks of [ nBegin, nEnd ) of nGrain elements each,
+// and combines the partial results left to right with fnCombine, starting from tIdentity.
+// NOTE: pass a fixed nGrain to get the same chunking - and thus the same result - on any machine.
+// If nGrain <= 0 the grain size is derived from the number of threads in the pool.
+template <class T, class F, class C>
+T ParallelReduce( long long nBegin, long long nEnd, T tIdentity, F fnChunk, C fnCombine, long long nGrain = 0, ThreadPool &pool = GlobalPool()) {
+    if (nEnd <= nBegin) {
+        return tIdentity;
+    }
+    if (nGrain <= 0) {
+        nGrain = PoolGrainSize( nEnd - nBegin, pool );
+    }
+    long long nChunks = (nEnd - nBegin + nGrain - 1) / nGrain;
+    std::vector<T> vPartials( nChunks, tIdentity );
+    TaskGroup tg( pool );
+    for (long long c = 0; c < nChunks; c++) {
+        long long lo = nBegin + c * nGrain;
+        long long hi = std::min( nEnd, lo + nGrain );
+        tg.Run( [&fnChunk, &vPartials, c, lo, hi]() { vPartials[c] = fnChunk( lo, hi ); } );
+    }
+    tg.Wait();
+    // combine in index order, so that the result doesn't depend on the scheduling
+    T tResult = tIdentity;
+    for (auto &p : vPartials) {
+        tResult = fnCombine( tResult, p );
+    }
+    return tResult;
+}
+
+#endif // THREAD_POOL_H